@@ -0,0 +1,72 @@
+#ifndef ANALYSIS_LOOP_HPP
+#define ANALYSIS_LOOP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "market_event_bus.hpp"
+#include "performance_monitor.hpp"
+#include "real_volatility_arbitrage.hpp"
+#include "real_cross_asset_arbitrage.hpp"
+#include "multi_leg_arbitrage.hpp"
+#include "risk_manager.hpp"
+#include "basis_scanner.hpp"
+
+using namespace std;
+
+// Drives the analyzers from market events instead of a polling timer. The
+// thread blocks on its own cursor; whatever is queued when it wakes is one
+// burst, after which every analyzer drains its cursor once, so each pair is
+// recomputed at most once per burst however many updates it saw. Detection
+// latency runs from the oldest event of the burst to the end of the scan.
+class AnalysisLoop {
+public:
+    struct Consumers {
+        RealVolatilityArbitrage& volatility;
+        RealCrossAssetArbitrage& cross_asset;
+        MultiLegArbitrageEngine* multi_leg;  // optional
+        RiskManager& risk;
+        BasisScanner* basis = nullptr;  // optional
+    };
+
+private:
+    // Wake-up bound for noticing stop() in a quiet market.
+    static constexpr int IDLE_WAIT_MS = 100;
+
+    Consumers consumers;
+    MarketEventCursor trigger{market_event_bus};
+    thread worker;
+    atomic<bool> running{false};
+
+    void run();
+    // Runs the analyzers on everything queued; returns whether any of them
+    // now reports an executable opportunity.
+    bool analyze();
+
+public:
+    // Book change to analyzers updated and scanned, per burst.
+    LatencyHistogram detection;
+    // The same, for bursts after which an opportunity was executable.
+    LatencyHistogram opportunity;
+    atomic<uint64_t> bursts{0};
+    atomic<uint64_t> events{0};
+
+    explicit AnalysisLoop(const Consumers& analyzers);
+    ~AnalysisLoop();
+
+    AnalysisLoop(const AnalysisLoop&) = delete;
+    AnalysisLoop& operator=(const AnalysisLoop&) = delete;
+
+    void start();
+    void stop();
+
+    void print_stats() const;
+
+    static void benchmark_detection_latency();
+};
+
+// Lowers the calling thread's scheduling priority; for reporting threads
+// that must never compete with the feed or analysis threads.
+void lower_thread_priority();
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef BASIS_SCANNER_HPP
+#define BASIS_SCANNER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "market_event_bus.hpp"
+
+using namespace std;
+
+// One instrument the scanner watches. Legs sharing a group are the same
+// underlying on different venues (or markets) and are all crossed with one
+// another.
+struct BasisLeg {
+    InstrumentId instrument;
+    uint32_t group;
+    double taker_rate;
+    string label;
+};
+
+// Every registry instrument, grouped by asset, with its base taker fee.
+vector<BasisLeg> default_basis_legs();
+
+// Buy at one leg's ask, sell at another's bid, net of both taker fees.
+struct BasisEdge {
+    InstrumentId buy;
+    InstrumentId sell;
+    double buy_ask;
+    double sell_bid;
+    double edge_bps;
+};
+
+// Cross-venue basis scanner. Each group keeps its legs' quotes as a
+// structure of arrays (fee-adjusted bid, reciprocal fee-adjusted ask) and
+// an edge matrix over every buy-here/sell-there combination. A BBO change
+// rewrites only its leg's row and column with SIMDOptimizer's AVX2 kernels,
+// so an update costs one pass over its own group whatever the number of
+// groups, and the count of combinations above min_edge_bps is kept as it
+// goes. Edges are float: ample for basis points on any listed price.
+class BasisScanner {
+private:
+    static constexpr uint32_t NO_LANE = UINT32_MAX;
+
+    struct Group {
+        size_t lane_base = 0;    // first lane in the quote arrays
+        size_t edge_base = 0;    // first cell in the edge matrix
+        size_t stride = 0;       // lanes, padded to a multiple of 8
+        vector<uint32_t> legs;   // leg index of each lane
+    };
+
+    vector<BasisLeg> legs;
+    vector<Group> groups;
+    vector<uint32_t> leg_group;
+    vector<uint32_t> leg_lane;
+    vector<uint32_t> instrument_leg;  // NO_LANE if not scanned
+
+    // Per lane; empty quotes leave both at 0, pinning every edge through
+    // the lane to -1.
+    vector<float> net_bids;        // bid * (1 - taker)
+    vector<float> inv_gross_asks;  // 1 / (ask * (1 + taker))
+    vector<double> bids;
+    vector<double> asks;
+    // edges[edge_base + buy_lane * stride + sell_lane], as a fraction.
+    vector<float> edges;
+    vector<float> column;
+
+    float threshold;
+    size_t above = 0;
+
+    MarketEventCursor market_events{market_event_bus};
+    mutable mutex scanner_mutex;
+
+public:
+    explicit BasisScanner(const vector<BasisLeg>& leg_table = default_basis_legs(), double min_edge_bps = 0.0);
+
+    BasisScanner(const BasisScanner&) = delete;
+    BasisScanner& operator=(const BasisScanner&) = delete;
+
+    // Applies one quote (0 for a side that is empty); not thread safe, the
+    // polling thread's own path.
+    void update(InstrumentId instrument, double bid, double ask);
+
+    // Feeds every BboChange since the last call into update(). Returns the
+    // events read.
+    size_t poll_market_events();
+
+    // Combinations currently above min_edge_bps.
+    size_t opportunities() const;
+    // The best `limit` combinations, best first, whatever their edge.
+    vector<BasisEdge> best_edges(size_t limit) const;
+    size_t combinations() const;
+
+    void print_basis_opportunities() const;
+
+    static void benchmark_basis_scan();
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef BBO_SLOT_HPP
+#define BBO_SLOT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "fast_orderbook.hpp"
+#include "seqlock.hpp"
+
+using namespace std;
+
+// Where a best bid/offer came from: the top of the diff-depth book, or the
+// venue's dedicated top-of-book channel (Binance bookTicker, Bybit
+// orderbook.1, OKX bbo-tbt).
+enum class BboSource : uint8_t { Depth, Ticker };
+
+constexpr size_t BBO_SOURCE_COUNT = 2;
+
+const char* bbo_source_name(BboSource source);
+
+struct Bbo {
+    PriceLevel bid;
+    PriceLevel ask;
+    // The venue's book sequence the quote is as of.
+    int64_t sequence = 0;
+    int64_t update_ns = 0;
+    BboSource source = BboSource::Depth;
+
+    bool has_quotes() const { return bid.quantity.raw > 0 && ask.quantity.raw > 0; }
+
+    Price mid_price() const {
+        if (!has_quotes()) return Price{};
+        return Price((bid.price.raw + ask.price.raw) / 2);
+    }
+
+    bool same_quotes(const Bbo& other) const {
+        return bid.price == other.bid.price && bid.quantity == other.bid.quantity &&
+               ask.price == other.ask.price && ask.quantity == other.ask.quantity;
+    }
+};
+
+// The one level a side a top-of-book channel maintains. Bybit only resends
+// the side that changed, so each side is kept until replaced; a zero size
+// at the current price leaves that side unknown until the next update.
+struct TopOfBook {
+    PriceLevel bid;
+    PriceLevel ask;
+
+    void apply_bid(Price price, Qty quantity) { apply(bid, price, quantity); }
+    void apply_ask(Price price, Qty quantity) { apply(ask, price, quantity); }
+    void clear() { *this = TopOfBook{}; }
+    bool has_quotes() const { return bid.quantity.raw > 0 && ask.quantity.raw > 0; }
+
+private:
+    static void apply(PriceLevel& side, Price price, Qty quantity) {
+        if (quantity.raw > 0) {
+            side = {price, quantity};
+        } else if (price == side.price) {
+            side = PriceLevel{};
+        }
+    }
+};
+
+// Latest best bid/offer of one instrument, fed by both sources and read by
+// the strategy engines. Offers are ordered by the venue's book sequence, so
+// whichever source delivers a state first publishes it and the later copy is
+// dropped. Single writer: whichever thread applies the instrument's book
+// (see BookLane). Readers go through the seqlock and never block it.
+class BboSlot {
+private:
+    SeqLock<Bbo> published;
+    Bbo current;
+
+    // The oldest win of each source the other one has not caught up with.
+    struct Lead {
+        int64_t sequence = 0;
+        int64_t ns = 0;
+    };
+    array<Lead, BBO_SOURCE_COUNT> pending{};
+
+    void catch_up(size_t source, int64_t sequence, int64_t now_ns) {
+        size_t other = 1 - source;
+        if (pending[other].sequence == 0 || sequence < pending[other].sequence) return;
+        lead_ns[other].fetch_add(static_cast<uint64_t>(now_ns - pending[other].ns), memory_order_relaxed);
+        lead_samples[other].fetch_add(1, memory_order_relaxed);
+        pending[other] = Lead{};
+    }
+
+public:
+    // Quote changes each source published first, and how far ahead it was.
+    array<atomic<uint64_t>, BBO_SOURCE_COUNT> wins{};
+    array<atomic<uint64_t>, BBO_SOURCE_COUNT> lead_ns{};
+    array<atomic<uint64_t>, BBO_SOURCE_COUNT> lead_samples{};
+
+    Bbo load() const { return published.load(); }
+
+    // Empty until the next offer, e.g. when the depth book was cleared.
+    void reset() {
+        current = Bbo{};
+        pending.fill(Lead{});
+        published.store(current);
+    }
+
+    // Returns whether the published quote changed; a newer state with the
+    // same prices and sizes is stored but does not count.
+    bool offer(BboSource source, const PriceLevel& bid, const PriceLevel& ask, int64_t sequence, int64_t now_ns) {
+        size_t s = static_cast<size_t>(source);
+        catch_up(s, sequence, now_ns);
+        if (sequence <= current.sequence) return false;
+
+        Bbo next;
+        next.bid = bid;
+        next.ask = ask;
+        next.sequence = sequence;
+        next.update_ns = now_ns;
+        next.source = source;
+        bool changed = !next.same_quotes(current);
+        if (changed) {
+            wins[s].fetch_add(1, memory_order_relaxed);
+            if (pending[s].sequence == 0) pending[s] = {sequence, now_ns};
+        }
+        current = next;
+        published.store(current);
+        return changed;
+    }
+
+    static void benchmark_bbo_sources();
+};
+
+#endif
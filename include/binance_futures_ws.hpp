@@ -1,3 +0,0 @@
-#pragma once
-
-void start_binance_futures_ws();
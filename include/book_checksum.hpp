@@ -0,0 +1,359 @@
+#ifndef BOOK_CHECKSUM_HPP
+#define BOOK_CHECKSUM_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "fast_orderbook.hpp"
+
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace crc32_detail {
+
+constexpr array<uint32_t, 256> make_table() {
+    array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+inline constexpr array<uint32_t, 256> TABLE = make_table();
+
+inline uint32_t table_update(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) crc = TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+}
+
+// Streaming CRC-32 (IEEE 802.3, the zlib one). The SSE4.2 crc32 instruction
+// implements CRC-32C, a different polynomial, so with PCLMUL the input is
+// instead folded with carry-less multiplies: four independent 128-bit lanes
+// over each 64-byte block, merged and reduced once in finish(). The last
+// partial block and non-PCLMUL builds use a table.
+//
+// Producers can format straight into the staging block: reserve() hands out
+// room for up to SLACK bytes and commit() folds whatever blocks filled up,
+// so no message string is ever built.
+class Crc32 {
+public:
+    static constexpr size_t SLACK = 128;
+
+private:
+    static constexpr size_t BLOCK = 64;
+
+    uint32_t crc = 0xFFFFFFFFu;
+    alignas(16) uint8_t pending[BLOCK + SLACK];
+    size_t pending_length = 0;
+#ifdef __PCLMUL__
+    __m128i lanes[4];
+    bool has_folded = false;
+
+    // x^(4*128+32) and x^(4*128-32) mod P, bit-reflected: folds a lane 64 bytes ahead.
+    static __m128i fold4_constants() { return _mm_set_epi64x(0x1c6e41596, 0x154442bd4); }
+    // x^(128+32) and x^(128-32) mod P: folds 16 bytes ahead.
+    static __m128i fold1_constants() { return _mm_set_epi64x(0x0ccaa009e, 0x1751997d0); }
+
+    static __m128i fold(__m128i x, __m128i k, __m128i next) {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11)), next);
+    }
+
+    static __m128i load(const uint8_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+
+    void fold_block(const uint8_t* block) {
+        if (!has_folded) {
+            for (int i = 0; i < 4; ++i) lanes[i] = load(block + 16 * i);
+            lanes[0] = _mm_xor_si128(lanes[0], _mm_cvtsi32_si128(static_cast<int>(crc)));
+            has_folded = true;
+            return;
+        }
+        __m128i k = fold4_constants();
+        for (int i = 0; i < 4; ++i) lanes[i] = fold(lanes[i], k, load(block + 16 * i));
+    }
+
+    // 128 -> 64 -> 32 bits, then Barrett reduction by the polynomial.
+    static uint32_t reduce(__m128i x) {
+        const __m128i low32 = _mm_set_epi32(0, 0, 0, -1);
+        __m128i folded64 = _mm_xor_si128(_mm_clmulepi64_si128(x, fold1_constants(), 0x10), _mm_srli_si128(x, 8));
+        __m128i folded32 = _mm_xor_si128(
+            _mm_clmulepi64_si128(_mm_and_si128(folded64, low32), _mm_set_epi64x(0, 0x163cd6124), 0x00),
+            _mm_srli_si128(folded64, 4));
+        const __m128i barrett = _mm_set_epi64x(0x1F7011641, 0x1DB710641);
+        __m128i t = _mm_clmulepi64_si128(_mm_and_si128(folded32, low32), barrett, 0x10);
+        t = _mm_clmulepi64_si128(_mm_and_si128(t, low32), barrett, 0x00);
+        return static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(t, folded32), 1));
+    }
+#endif
+
+public:
+    // Room for up to SLACK bytes; pass how many were written to commit().
+    char* reserve() { return reinterpret_cast<char*>(pending + pending_length); }
+
+    void commit(size_t length) {
+#ifdef __PCLMUL__
+        pending_length += length;
+        if (pending_length < BLOCK) return;
+        size_t folded = 0;
+        for (; folded + BLOCK <= pending_length; folded += BLOCK) fold_block(pending + folded);
+        pending_length -= folded;
+        memmove(pending, pending + folded, BLOCK);  // what is left is under a block
+#else
+        crc = crc32_detail::table_update(crc, pending, length);
+#endif
+    }
+
+    void update(const char* data, size_t length) {
+        while (length) {
+            size_t take = min(length, SLACK);
+            memcpy(reserve(), data, take);
+            commit(take);
+            data += take;
+            length -= take;
+        }
+    }
+
+    uint32_t finish() {
+#ifdef __PCLMUL__
+        const __m128i k = fold1_constants();
+        __m128i x = _mm_setzero_si128();
+        bool folding = has_folded;
+        if (folding) x = fold(fold(fold(lanes[0], k, lanes[1]), k, lanes[2]), k, lanes[3]);
+        size_t offset = 0;
+        for (; offset + 16 <= pending_length; offset += 16) {
+            if (folding) {
+                x = fold(x, k, load(pending + offset));
+            } else {
+                x = _mm_xor_si128(load(pending + offset), _mm_cvtsi32_si128(static_cast<int>(crc)));
+                folding = true;
+            }
+        }
+        if (folding) crc = reduce(x);
+        crc = crc32_detail::table_update(crc, pending + offset, pending_length - offset);
+#endif
+        return ~crc;
+    }
+
+    static uint32_t of(const char* data, size_t length) {
+        Crc32 crc;
+        crc.update(data, length);
+        return crc.finish();
+    }
+};
+
+namespace decimal_detail {
+
+struct DigitPairs {
+    char text[200];
+};
+
+constexpr DigitPairs make_digit_pairs() {
+    DigitPairs pairs{};
+    for (int i = 0; i < 100; ++i) {
+        pairs.text[2 * i] = static_cast<char>('0' + i / 10);
+        pairs.text[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}
+
+inline constexpr DigitPairs PAIRS = make_digit_pairs();
+
+inline void put_pair(char* out, uint32_t value) { memcpy(out, PAIRS.text + 2 * value, 2); }
+
+}
+
+// Writes a fixed-point value the way OKX prints it: no trailing fraction
+// zeros and no '.' on whole numbers ("3366", "0.5"). `out` needs 16 bytes
+// of slack past the result. Returns the length.
+inline size_t format_trimmed_decimal_scalar(int64_t raw, char* out) {
+    using decimal_detail::put_pair;
+    char* p = out;
+    if (raw < 0) {
+        *p++ = '-';
+        raw = -raw;
+    }
+    uint64_t integer = static_cast<uint64_t>(raw) / FIXED_POINT_SCALE;
+    uint32_t fraction = static_cast<uint32_t>(static_cast<uint64_t>(raw) % FIXED_POINT_SCALE);
+
+    size_t digits = 1;
+    for (uint64_t bound = 10; digits < 20 && integer >= bound; bound *= 10) ++digits;
+    char* q = p + digits;
+    while (integer >= 100) {
+        q -= 2;
+        put_pair(q, static_cast<uint32_t>(integer % 100));
+        integer /= 100;
+    }
+    if (integer >= 10) {
+        put_pair(q - 2, static_cast<uint32_t>(integer));
+    } else {
+        q[-1] = static_cast<char>('0' + integer);
+    }
+    p += digits;
+
+    if (fraction) {
+        *p++ = '.';
+        uint32_t high = fraction / 10000;
+        uint32_t low = fraction % 10000;
+        put_pair(p, high / 100);
+        put_pair(p + 2, high % 100);
+        put_pair(p + 4, low / 100);
+        put_pair(p + 6, low % 100);
+        // Trailing '0' characters are the high bytes of the little-endian word.
+        uint64_t word;
+        memcpy(&word, p, 8);
+        p += 8 - static_cast<size_t>(__builtin_clzll(word ^ 0x3030303030303030ULL) / 8);
+    }
+    return static_cast<size_t>(p - out);
+}
+
+#ifdef __SSSE3__
+namespace decimal_detail {
+
+// Eight decimal digits of a value below 1e8 as eight 16-bit lanes, most
+// significant first, with multiplies instead of divides.
+inline __m128i eight_digits(uint32_t value) {
+    const __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(value));
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, _mm_set1_epi32(static_cast<int>(0xd1b71759))), 45);
+    const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+    const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    const __m128i v2 = _mm_unpacklo_epi32(_mm_unpacklo_epi16(v1, v1), _mm_unpacklo_epi16(v1, v1));
+    // Each lane divided by 1000, 100, 10, 1 ...
+    const __m128i v3 = _mm_mulhi_epu16(v2, _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768));
+    const __m128i v4 = _mm_mulhi_epu16(v3, _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768));
+    // ... minus ten times its left neighbour leaves one digit per lane.
+    return _mm_sub_epi16(v4, _mm_slli_epi64(_mm_mullo_epi16(v4, _mm_set1_epi16(10)), 16));
+}
+
+// pshufb masks that shift a register left by 0..16 bytes.
+alignas(16) inline constexpr uint8_t SHIFT_LEFT[32] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+}
+
+// The whole value as 16 digits in one register (8 integer, 8 fraction);
+// leading and trailing zeros are then cut with two bit scans.
+inline size_t format_trimmed_decimal(int64_t raw, char* out) {
+    using namespace decimal_detail;
+    if (raw < 0 || raw >= FIXED_POINT_SCALE * FIXED_POINT_SCALE) return format_trimmed_decimal_scalar(raw, out);
+
+    uint64_t value = static_cast<uint64_t>(raw);
+    __m128i digits = _mm_packus_epi16(eight_digits(static_cast<uint32_t>(value / FIXED_POINT_SCALE)),
+                                      eight_digits(static_cast<uint32_t>(value % FIXED_POINT_SCALE)));
+    uint32_t nonzero = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(digits, _mm_setzero_si128())));
+    digits = _mm_add_epi8(digits, _mm_set1_epi8('0'));
+
+    // Keep at least the units digit of the integer part.
+    uint32_t integer_nonzero = nonzero & 0x7F;
+    size_t skip = integer_nonzero ? static_cast<size_t>(__builtin_ctz(integer_nonzero)) : 7;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_shuffle_epi8(digits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHIFT_LEFT + skip))));
+    char* p = out + (8 - skip);
+
+    uint32_t fraction_nonzero = (nonzero >> 8) & 0xFF;
+    if (fraction_nonzero) {
+        *p++ = '.';
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_srli_si128(digits, 8));
+        p += 32 - __builtin_clz(fraction_nonzero);
+    }
+    return static_cast<size_t>(p - out);
+}
+#else
+inline size_t format_trimmed_decimal(int64_t raw, char* out) {
+    return format_trimmed_decimal_scalar(raw, out);
+}
+#endif
+
+// OKX `books` checksum: CRC-32 of "bid1Px:bid1Sz:ask1Px:ask1Sz:bid2Px:..."
+// over the top 25 levels of each side (a missing level is skipped), read as
+// a signed 32-bit integer. The book is fixed point, so prices and sizes are
+// re-rendered in OKX's format straight into the CRC.
+constexpr size_t OKX_CHECKSUM_LEVELS = 25;
+
+// "price:size" of one level; `out` needs 64 bytes. Returns the length.
+inline size_t render_okx_level(const PriceLevel& level, char* out) {
+    char* p = out + format_trimmed_decimal(level.price.raw, out);
+    *p++ = ':';
+    p += format_trimmed_decimal(level.quantity.raw, p);
+    return static_cast<size_t>(p - out);
+}
+
+// Walks the top levels in checksum order, calling render(level, is_bid, out)
+// -> length to write each one into the CRC's staging block.
+template<typename Render>
+int32_t okx_book_checksum(const FastOrderbook& book, Render&& render) {
+    PriceLevel bids[OKX_CHECKSUM_LEVELS];
+    PriceLevel asks[OKX_CHECKSUM_LEVELS];
+    size_t bid_count = book.top_bids(OKX_CHECKSUM_LEVELS, bids);
+    size_t ask_count = book.top_asks(OKX_CHECKSUM_LEVELS, asks);
+
+    Crc32 crc;
+    bool first = true;
+    auto put = [&](const PriceLevel& level, bool is_bid) {
+        char* start = crc.reserve();
+        char* p = start;
+        if (!first) *p++ = ':';
+        first = false;
+        p += render(level, is_bid, p);
+        crc.commit(static_cast<size_t>(p - start));
+    };
+    for (size_t i = 0; i < max(bid_count, ask_count); ++i) {
+        if (i < bid_count) put(bids[i], true);
+        if (i < ask_count) put(asks[i], false);
+    }
+    return static_cast<int32_t>(crc.finish());
+}
+
+inline int32_t okx_book_checksum(const FastOrderbook& book) {
+    return okx_book_checksum(book, [](const PriceLevel& level, bool, char* out) { return render_okx_level(level, out); });
+}
+
+// Per-book checksum state. An update only touches a few of the 50 levels,
+// so each level's text is cached per side in a slot picked by its tick, and
+// only new or changed levels are formatted again. The top 25 levels rarely
+// span more than SLOTS ticks, so they seldom evict each other.
+class OkxBookChecksum {
+private:
+    static constexpr size_t SLOTS = 64;
+
+    struct alignas(64) Rendered {
+        int64_t price = -1;
+        int64_t quantity = -1;
+        uint8_t length = 0;
+        char text[47];
+    };
+    static_assert(sizeof(Rendered) == 64, "one cache line per level");
+
+    array<Rendered, SLOTS> cache[2];
+
+public:
+    int32_t operator()(const FastOrderbook& book) {
+        const InstrumentSpec& spec = book.spec();
+        return okx_book_checksum(book, [&](const PriceLevel& level, bool is_bid, char* out) -> size_t {
+            size_t slot = static_cast<size_t>(spec.to_ticks(level.price)) & (SLOTS - 1);
+            Rendered& entry = cache[is_bid][slot];
+            if (entry.price != level.price.raw || entry.quantity != level.quantity.raw) {
+                char text[64];
+                size_t length = render_okx_level(level, text);
+                entry.price = level.price.raw;
+                entry.quantity = level.quantity.raw;
+                entry.length = static_cast<uint8_t>(length);
+                memcpy(entry.text, text, sizeof(entry.text));
+            }
+            memcpy(out, entry.text, sizeof(entry.text));
+            return entry.length;
+        });
+    }
+};
+
+void benchmark_book_checksum();
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef BOOK_PIPELINE_HPP
+#define BOOK_PIPELINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fast_orderbook.hpp"
+#include "bbo_slot.hpp"
+#include "book_checksum.hpp"
+#include "market_event_bus.hpp"
+
+using namespace std;
+
+class BookPipeline;
+
+// One normalized change to a book, as the feed decoded it. A message is a
+// run of Bid/Ask records closed by a Commit; readers only ever see the book
+// at a Commit.
+struct LevelUpdate {
+    enum class Kind : uint8_t {
+        Bid,
+        Ask,
+        Clear,      // a snapshot follows
+        Reset,      // the feed restarted: empty the book and the BBO slot
+        Commit,     // end of message; `sequence` is the venue's book sequence
+        TickerBid,  // top-of-book channel, always followed by its TickerAsk
+        TickerAsk
+    };
+
+    Kind kind;
+    bool has_checksum = false;
+    int32_t checksum = 0;
+    PriceLevel level;
+    int64_t sequence = 0;
+};
+
+// Everything a feed does to one book. The reactor thread that owns the
+// feed is the only producer; whichever thread owns the book (the book
+// thread with a BookPipeline, otherwise the reactor itself) applies it.
+// Publishing, the depth offer to the BBO slot, the OKX checksum and the
+// BookUpdate/BboChange events on the market event bus all happen on the
+// book's thread, so the slot keeps a single writer.
+class BookLane {
+public:
+    static constexpr size_t RING_SIZE = 8192;
+    // Most records the book thread takes from one lane before moving on.
+    static constexpr size_t DRAIN_BATCH = 256;
+
+    // Called on the book's thread when a Commit fails its checksum, with the
+    // commit's sequence. The lane has already emptied and published the
+    // book, and ignores updates until the next Clear or Reset.
+    function<void(int64_t)> on_checksum_mismatch;
+
+    // Times the producer found the ring full and had to wait.
+    atomic<uint64_t> stalls{0};
+
+private:
+    FastOrderbook* book;
+    BboSlot* bbo;
+    unique_ptr<OkxBookChecksum> checksum;
+    BookPipeline* pipeline;
+    MarketEventBus* events;
+    InstrumentId instrument;
+    LockFreeCircularBuffer<LevelUpdate, RING_SIZE> ring;
+
+    // Book thread state.
+    bool diverged = false;
+    PriceLevel ticker_bid;
+
+    void push(const LevelUpdate& update);
+    void finish(const LevelUpdate& commit, int64_t now_ns);
+    void book_event(int64_t sequence);
+    void bbo_event(BboSource source, const PriceLevel& bid, const PriceLevel& ask, int64_t sequence);
+
+public:
+    // Events go to `events` (if any), tagged with `instrument`.
+    BookLane(FastOrderbook& book, BboSlot& bbo, unique_ptr<OkxBookChecksum> checksum, BookPipeline* pipeline,
+             MarketEventBus* events = nullptr, InstrumentId instrument = INVALID_INSTRUMENT);
+
+    BookLane(const BookLane&) = delete;
+    BookLane& operator=(const BookLane&) = delete;
+
+    // Producer side (the feed's reactor thread). apply_bid/apply_ask make
+    // the lane a level sink for the decoders.
+    void apply_bid(Price price, Qty quantity) { push({LevelUpdate::Kind::Bid, false, 0, {price, quantity}, 0}); }
+    void apply_ask(Price price, Qty quantity) { push({LevelUpdate::Kind::Ask, false, 0, {price, quantity}, 0}); }
+    void clear() { push({LevelUpdate::Kind::Clear, false, 0, {}, 0}); }
+    void reset() { push({LevelUpdate::Kind::Reset, false, 0, {}, 0}); }
+    void commit(int64_t sequence, bool has_checksum = false, int64_t checksum_value = 0) {
+        push({LevelUpdate::Kind::Commit, has_checksum, static_cast<int32_t>(checksum_value), {}, sequence});
+    }
+    void ticker(const PriceLevel& bid, const PriceLevel& ask, int64_t sequence) {
+        push({LevelUpdate::Kind::TickerBid, false, 0, bid, sequence});
+        push({LevelUpdate::Kind::TickerAsk, false, 0, ask, sequence});
+    }
+
+    // Book side. Applies a run of records, publishing once at the last
+    // Commit among them rather than at every one.
+    void consume(const LevelUpdate* updates, size_t count);
+    // Book thread: applies up to DRAIN_BATCH queued records. Returns how many.
+    size_t drain();
+    bool idle() const { return ring.empty(); }
+};
+
+// The dedicated book thread. It round-robins over every registered lane,
+// applying each ring's backlog as one batch, and parks on a condition
+// variable when all of them are empty. Producers only touch the condition
+// variable when the thread has said it is parked.
+class BookPipeline {
+private:
+    // Empty passes over the lanes before the thread parks.
+    static constexpr size_t SPIN_ROUNDS = 64;
+
+    vector<BookLane*> lanes;
+    thread worker;
+    atomic<bool> running{false};
+    atomic<bool> parked{false};
+    mutex park_mutex;
+    condition_variable park_cv;
+
+    void run();
+
+public:
+    atomic<uint64_t> records{0};
+    atomic<uint64_t> batches{0};
+
+    BookPipeline() = default;
+    ~BookPipeline();
+
+    BookPipeline(const BookPipeline&) = delete;
+    BookPipeline& operator=(const BookPipeline&) = delete;
+
+    // Before start() only.
+    void add(BookLane& lane) { lanes.push_back(&lane); }
+
+    void start();
+    void stop();
+
+    // Producer side, after pushing records that should not wait.
+    void wake() {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (parked.load(memory_order_relaxed)) {
+            lock_guard<mutex> lock(park_mutex);
+            park_cv.notify_one();
+        }
+    }
+
+    uint64_t stalls() const;
+    void print_stats() const;
+
+    static void benchmark_pipeline();
+};
+
+#endif
@@ -1,7 +0,0 @@
-#ifndef BYBIT_WS_HPP
-#define BYBIT_WS_HPP
-
-void start_bybit_spot_ws();
-void start_bybit_futures_ws();
-
-#endif
@@ -1,7 +0,0 @@
-#ifndef ETH_BINANCE_WS_HPP
-#define ETH_BINANCE_WS_HPP
-
-void start_eth_binance_spot_ws();
-void start_eth_binance_futures_ws();
-
-#endif
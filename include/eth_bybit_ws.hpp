@@ -1,7 +0,0 @@
-#ifndef ETH_BYBIT_WS_HPP
-#define ETH_BYBIT_WS_HPP
-
-void start_eth_bybit_spot_ws();
-void start_eth_bybit_futures_ws();
-
-#endif
@@ -1,7 +0,0 @@
-#ifndef ETH_OKX_WS_HPP
-#define ETH_OKX_WS_HPP
-
-void start_eth_okx_spot_ws();
-void start_eth_okx_futures_ws();
-
-#endif
@@ -2,183 +2,233 @@
 #define FAST_JSON_PARSER_HPP
 
 #include <string>
-#include <vector>
-#include <unordered_map>
-#include <memory>
+#include <string_view>
+#include <cstdint>
 #include <cstring>
-#include <cstdlib>
+#include "fixed_point.hpp"
 
 using namespace std;
 
-class FastJsonParser {
+// Forward-only scanner over a JSON payload. It never copies or unescapes:
+// strings come back as views into the payload, which is all the depth feeds
+// need since none of the fields we read can contain escapes.
+class JsonCursor {
 private:
-    static thread_local vector<string> price_buffer;
-    static thread_local vector<string> quantity_buffer;
-    static thread_local unordered_map<string, string> field_cache;
-    
-    static double fast_strtod(const string& str) {
-        if (str.empty()) return 0.0;
-        return strtod(str.c_str(), nullptr);
+    const char* p;
+    const char* end;
+
+    // True if the quote at `quote` is preceded by an even run of backslashes,
+    // i.e. it really closes the string.
+    static bool even_backslashes_before(const char* quote) {
+        size_t run = 0;
+        while (quote[-1 - static_cast<ptrdiff_t>(run)] == '\\') ++run;
+        return run % 2 == 0;
     }
-    
-    static const char* find_field_simple(const char* json, size_t length, const char* field) {
-        if (!json || !field || length == 0) return nullptr;
-        
-        string search_pattern = "\"" + string(field) + "\"";
-        const char* result = strstr(json, search_pattern.c_str());
-        return result;
+
+    static bool is_delimiter(char c) {
+        return c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
     }
-    
-    static string extract_string_value(const char* start, const char* end) {
-        if (!start || !end || start >= end) return "";
-        
-        const char* quote_start = strchr(start, '"');
-        if (!quote_start || quote_start >= end) return "";
-        quote_start++; 
-        
-        const char* quote_end = strchr(quote_start, '"');
-        if (!quote_end || quote_end >= end) return "";
-        
-        return string(quote_start, quote_end - quote_start);
+
+public:
+    JsonCursor(const char* begin, const char* finish) : p(begin), end(finish) {}
+    explicit JsonCursor(string_view text) : p(text.data()), end(text.data() + text.size()) {}
+
+    void skip_ws() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
     }
-    
-    static vector<pair<double, double>> extract_price_quantity_array(const char* json, const char* field_name) {
-        vector<pair<double, double>> result;
-        
-        const char* field_pos = strstr(json, field_name);
-        if (!field_pos) return result;
-        
-        const char* array_start = strchr(field_pos, '[');
-        if (!array_start) return result;
-        array_start++; // Skip '['
-        
-        const char* array_end = strchr(array_start, ']');
-        if (!array_end) return result;
-        
-        const char* current = array_start;
-        while (current < array_end) {
-            const char* sub_array_start = strchr(current, '[');
-            if (!sub_array_start || sub_array_start >= array_end) break;
-            sub_array_start++; // Skip '['
-            
-            const char* sub_array_end = strchr(sub_array_start, ']');
-            if (!sub_array_end || sub_array_end >= array_end) break;
-            
-            const char* comma = strchr(sub_array_start, ',');
-            if (comma && comma < sub_array_end) {
-                string price_str = extract_string_value(sub_array_start, comma);
-                string qty_str = extract_string_value(comma + 1, sub_array_end);
-                
-                if (!price_str.empty() && !qty_str.empty()) {
-                    double price = fast_strtod(price_str);
-                    double quantity = fast_strtod(qty_str);
-                    if (price > 0.0 && quantity > 0.0) {
-                        result.emplace_back(price, quantity);
-                    }
-                }
-            }
-            
-            current = sub_array_end + 1;
+
+    bool consume(char c) {
+        skip_ws();
+        if (p < end && *p == c) {
+            ++p;
+            return true;
         }
-        
-        return result;
+        return false;
     }
-    
-public:
-    struct OrderbookUpdate {
-        vector<pair<double, double>> bids;
-        vector<pair<double, double>> asks;
-        string exchange;
-        string symbol;
-        uint64_t timestamp;
-        bool is_snapshot;
-        
-        OrderbookUpdate() : timestamp(0), is_snapshot(false) {}
-    };
-    
-    static bool parse_orderbook(const string& json_data, OrderbookUpdate& update) {
-        if (json_data.empty()) return false;
-        
-        const char* json = json_data.c_str();
-        
-        if (json_data.find("\"b\":") != string::npos && json_data.find("\"a\":") != string::npos) {
-            return parse_binance_format(json_data, update);
-        } else if (json_data.find("\"data\":") != string::npos) {
-            if (json_data.find("\"topic\":") != string::npos) {
-                return parse_bybit_format(json_data, update);
-            } else {
-                return parse_okx_format(json_data, update);
+
+    bool peek(char c) {
+        skip_ws();
+        return p < end && *p == c;
+    }
+
+    bool string_token(string_view& out) {
+        skip_ws();
+        if (p >= end || *p != '"') return false;
+        const char* start = ++p;
+        const char* close;
+        do {
+            close = static_cast<const char*>(memchr(p, '"', end - p));
+            if (!close) return false;
+            p = close + 1;
+        } while (close[-1] == '\\' && !even_backslashes_before(close));
+        out = string_view(start, close - start);
+        return true;
+    }
+
+    // A string's contents or a bare number/literal, as written.
+    bool scalar_token(string_view& out) {
+        skip_ws();
+        if (p < end && *p == '"') return string_token(out);
+        const char* start = p;
+        while (p < end && !is_delimiter(*p)) ++p;
+        out = string_view(start, p - start);
+        return p != start;
+    }
+
+    bool skip_value() {
+        skip_ws();
+        if (p >= end) return false;
+        if (*p == '"') {
+            string_view ignored;
+            return string_token(ignored);
+        }
+        if (*p != '{' && *p != '[') {
+            string_view ignored;
+            return scalar_token(ignored);
+        }
+        int depth = 0;
+        while (p < end) {
+            char c = *p++;
+            if (c == '"') {
+                const char* close;
+                do {
+                    close = static_cast<const char*>(memchr(p, '"', end - p));
+                    if (!close) return false;
+                    p = close + 1;
+                } while (close[-1] == '\\' && !even_backslashes_before(close));
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) return true;
             }
         }
-        
         return false;
     }
-    
-    static bool parse_binance_format(const string& json, OrderbookUpdate& update) {
-        const char* json_cstr = json.c_str();
-        
-        update.bids = extract_price_quantity_array(json_cstr, "\"b\":");
-        
-        update.asks = extract_price_quantity_array(json_cstr, "\"a\":");
-        
-        update.exchange = "Binance";
-        update.symbol = "BTCUSDT";
-        update.is_snapshot = true;
-        update.timestamp = 0; // Simplified
-        
-        return !update.bids.empty() || !update.asks.empty();
+
+    // The raw text of the next value, for parsing later.
+    bool value_span(string_view& out) {
+        skip_ws();
+        const char* start = p;
+        if (!skip_value()) return false;
+        out = string_view(start, p - start);
+        return true;
     }
-    
-    static bool parse_bybit_format(const string& json, OrderbookUpdate& update) {
-        if (json.find("\"data\":") == string::npos) return false;
-        
-        const char* json_cstr = json.c_str();
-        const char* data_start = strstr(json_cstr, "\"data\":");
-        if (!data_start) return false;
-        
-        update.bids = extract_price_quantity_array(data_start, "\"b\":");
-        update.asks = extract_price_quantity_array(data_start, "\"a\":");
-        
-        update.exchange = "Bybit";
-        update.symbol = "BTCUSDT";
-        update.is_snapshot = json.find("\"type\":\"snapshot\"") != string::npos;
-        update.timestamp = 0; // Simplified
-        
-        return !update.bids.empty() || !update.asks.empty();
+
+    // Integer written either bare or quoted ("1597026383085").
+    bool int_value(int64_t& out) {
+        string_view token;
+        if (!scalar_token(token) || token.empty()) return false;
+        size_t i = 0;
+        bool negative = token[0] == '-';
+        if (negative) ++i;
+        if (i == token.size()) return false;
+        int64_t value = 0;
+        for (; i < token.size(); ++i) {
+            unsigned digit = static_cast<unsigned>(token[i] - '0');
+            if (digit >= 10) return false;
+            value = value * 10 + digit;
+        }
+        out = negative ? -value : value;
+        return true;
     }
-    
-    static bool parse_okx_format(const string& json, OrderbookUpdate& update) {
-        if (json.find("\"data\":") == string::npos) return false;
-        
-        const char* json_cstr = json.c_str();
-        const char* data_start = strstr(json_cstr, "\"data\":");
-        if (!data_start) return false;
-        
-        update.bids = extract_price_quantity_array(data_start, "\"bids\":");
-        update.asks = extract_price_quantity_array(data_start, "\"asks\":");
-        
-        update.exchange = "OKX";
-        update.symbol = "BTCUSDT";
-        update.is_snapshot = true; 
-        update.timestamp = 0; 
-        
-        return !update.bids.empty() || !update.asks.empty();
+
+    // Calls fn(key) once per member; fn must consume the value and return
+    // false to abort.
+    template<typename Fn>
+    bool for_each_member(Fn&& fn) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        do {
+            string_view key;
+            if (!string_token(key) || !consume(':')) return false;
+            if (!fn(key)) return false;
+        } while (consume(','));
+        return consume('}');
     }
-    
-    static void initialize_parsers() {
-        price_buffer.reserve(1000);
-        quantity_buffer.reserve(1000);
+};
+
+// Normalized view of one depth message. Level arrays are kept as raw spans
+// so the caller can check sequencing before anything touches the book.
+struct DepthMessage {
+    bool is_snapshot = false;
+    string_view symbol;
+    string_view event;
+    // Stream or topic name, where the venue sends one (tells a top-of-book
+    // message from a depth message on a shared connection).
+    string_view channel;
+    string_view bids;
+    string_view asks;
+    // Binance bookTicker carries the touch as scalars: "b"/"a" are then
+    // prices and these the sizes.
+    string_view bid_size;
+    string_view ask_size;
+    int64_t event_time_ms = 0;
+    int64_t first_update_id = 0;
+    int64_t last_update_id = 0;
+    int64_t prev_update_id = -1;
+    // Bybit's cross sequence, shared by every depth of an instrument's book.
+    int64_t cross_sequence = 0;
+    int64_t checksum = 0;
+    bool has_checksum = false;
+
+    bool has_levels() const { return !bids.empty() || !asks.empty(); }
+
+    // What orders this message against others of the same book on any
+    // channel.
+    int64_t book_sequence() const { return cross_sequence != 0 ? cross_sequence : last_update_id; }
+};
+
+// Level conversion shared by every depth decoder (see feed_decoder.hpp).
+// Nothing here allocates: each level is converted straight to fixed point
+// and handed to the sink.
+class FastJsonParser {
+private:
+    // LevelFields is the venue's level arity: ["p","q"] for Binance/Bybit,
+    // ["p","q","0","n"] for OKX. Only price and quantity are read.
+    template<size_t LevelFields, typename Sink>
+    static bool apply_side(string_view levels, bool is_bid, Sink& sink) {
+        static_assert(LevelFields >= 2, "a level needs at least price and quantity");
+        if (levels.empty()) return true;
+        // Every level but the last few is followed by 16 more bytes of the
+        // same array, so its fields can be read in place.
+        const char* end = levels.data() + levels.size();
+        JsonCursor c(levels);
+        if (!c.consume('[')) return false;
+        if (c.consume(']')) return true;
+        do {
+            string_view price_text, qty_text;
+            if (!c.consume('[') || !c.scalar_token(price_text) || !c.consume(',') || !c.scalar_token(qty_text)) {
+                return false;
+            }
+            for (size_t i = 2; i < LevelFields; ++i) {
+                if (!c.consume(',') || !c.skip_value()) return false;
+            }
+            if (!c.consume(']')) return false;
+
+            int64_t price, qty;
+            if (!parse_fixed_point_pair(price_text.data(), price_text.size(), qty_text.data(), qty_text.size(),
+                                        price, qty, end - qty_text.data() >= 16)) {
+                return false;
+            }
+            if (is_bid) {
+                sink.apply_bid(Price(price), Qty(qty));
+            } else {
+                sink.apply_ask(Price(price), Qty(qty));
+            }
+        } while (c.consume(','));
+        return c.consume(']');
     }
-    
-    static void cleanup_parsers() {
-        price_buffer.clear();
-        quantity_buffer.clear();
-        field_cache.clear();
+
+public:
+    // Feeds every level of the message into sink.apply_bid/apply_ask.
+    // Returns false if a level is malformed; levels before it are applied.
+    template<size_t LevelFields, typename Sink>
+    static bool apply_levels(const DepthMessage& message, Sink& sink) {
+        return apply_side<LevelFields>(message.bids, true, sink) &&
+               apply_side<LevelFields>(message.asks, false, sink);
     }
-};
 
-thread_local vector<string> FastJsonParser::price_buffer;
-thread_local vector<string> FastJsonParser::quantity_buffer;
-thread_local unordered_map<string, string> FastJsonParser::field_cache;
+    static void benchmark_against_dom();
+};
 
 #endif
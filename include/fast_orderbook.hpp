@@ -5,9 +5,15 @@
 #include <array>
 #include <atomic>
 #include <memory>
-#include <string>        
-#include <algorithm>     
-#include <cfloat>        
+#include <string>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <chrono>
+#include <type_traits>
+#include "fixed_point.hpp"
+#include "seqlock.hpp"
 
 #ifdef __SSE2__
 #include <immintrin.h>
@@ -15,139 +21,635 @@
 
 using namespace std;
 
-template<size_t Size>
+// Single-producer single-consumer ring of trivially copyable records. Each
+// side keeps a private copy of the other side's index and only rereads the
+// shared one when the copy says the ring is full (or empty), so in steady
+// state the two threads do not bounce each other's cache lines. Size must
+// be a power of two; one slot is kept free to tell full from empty.
+template<typename T, size_t Size>
 class LockFreeCircularBuffer {
+    static_assert(is_trivially_copyable<T>::value, "ring records must be trivially copyable");
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "ring size must be a power of two");
+    static constexpr size_t MASK = Size - 1;
+
 private:
-    alignas(64) array<atomic<double>, Size> prices;
-    alignas(64) array<atomic<double>, Size> quantities;
     alignas(64) atomic<size_t> write_index{0};
+    size_t cached_read = 0;     // producer's view of read_index
     alignas(64) atomic<size_t> read_index{0};
-    
+    size_t cached_write = 0;    // consumer's view of write_index
+    alignas(64) array<T, Size> records;
+
 public:
-    bool try_push(double price, double quantity) {
+    // Producer side.
+    bool try_push(const T& record) {
         size_t current_write = write_index.load(memory_order_relaxed);
-        size_t next_write = (current_write + 1) % Size;
-        
-        if (next_write == read_index.load(memory_order_acquire)) {
-            return false; 
-        }
-        
-        prices[current_write].store(price, memory_order_relaxed);
-        quantities[current_write].store(quantity, memory_order_relaxed);
+        size_t next_write = (current_write + 1) & MASK;
+        if (next_write == cached_read) {
+            cached_read = read_index.load(memory_order_acquire);
+            if (next_write == cached_read) return false;
+        }
+        records[current_write] = record;
         write_index.store(next_write, memory_order_release);
         return true;
     }
-    
-    bool try_pop(double& price, double& quantity) {
+
+    // Consumer side.
+    bool try_pop(T& record) {
+        return pop_batch(&record, 1) == 1;
+    }
+
+    // Consumer side: up to `max` records in one index update.
+    size_t pop_batch(T* out, size_t max) {
         size_t current_read = read_index.load(memory_order_relaxed);
-        if (current_read == write_index.load(memory_order_acquire)) {
-            return false; 
+        if (current_read == cached_write) {
+            cached_write = write_index.load(memory_order_acquire);
+            if (current_read == cached_write) return 0;
         }
-        
-        price = prices[current_read].load(memory_order_relaxed);
-        quantity = quantities[current_read].load(memory_order_relaxed);
-        read_index.store((current_read + 1) % Size, memory_order_release);
-        return true;
+        size_t available = (cached_write - current_read) & MASK;
+        size_t n = min(available, max);
+        for (size_t i = 0; i < n; ++i) out[i] = records[(current_read + i) & MASK];
+        read_index.store((current_read + n) & MASK, memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        return read_index.load(memory_order_acquire) == write_index.load(memory_order_acquire);
     }
-    
+
     size_t size() const {
         size_t write = write_index.load(memory_order_relaxed);
         size_t read = read_index.load(memory_order_relaxed);
-        return (write >= read) ? (write - read) : (Size - read + write);
+        return (write - read) & MASK;
+    }
+
+    static constexpr size_t capacity() { return Size - 1; }
+};
+
+struct PriceLevel {
+    Price price;
+    Qty quantity;
+};
+
+// One point of a side's cumulative depth: taking everything from the best
+// level out to some price fills `quantity` for `notional` (price * quantity).
+struct DepthPoint {
+    double quantity = 0.0;
+    double notional = 0.0;
+};
+
+// What a taker gets walking one side of a book.
+struct DepthFill {
+    double quantity = 0.0;
+    double notional = 0.0;
+    bool complete = false;  // the published depth covered the request
+
+    double vwap() const { return quantity > 0 ? notional / quantity : 0.0; }
+};
+
+// What readers see of a book: the top levels of each side as of the last
+// message the feed thread applied, plus when that message landed.
+struct BookSnapshot {
+    static constexpr size_t DEPTH = 8;
+    // Past the published levels, the curve steps out in bands this far
+    // from the best price.
+    static constexpr size_t BANDS = 4;
+    static constexpr double BAND_BPS[BANDS] = {10.0, 25.0, 50.0, 100.0};
+    static constexpr size_t CURVE = DEPTH + BANDS;
+
+    PriceLevel bids[DEPTH];
+    PriceLevel asks[DEPTH];
+    uint32_t bid_depth = 0;
+    uint32_t ask_depth = 0;
+    uint32_t bid_count = 0;
+    uint32_t ask_count = 0;
+    int64_t update_ns = 0;
+
+    // Everything within each band of the best price, from the book's
+    // prefix sums; only the bands reaching past the published levels.
+    DepthPoint bid_bands[BANDS];
+    DepthPoint ask_bands[BANDS];
+    uint32_t bid_band_count = 0;
+    uint32_t ask_band_count = 0;
+
+    // Cumulative depth from the best level: a point per published level,
+    // then the bands. Exact at every point and linear in between, so inside
+    // a band it is the band's average price. Returns the points written.
+    uint32_t bid_curve(DepthPoint* out) const { return curve(bids, bid_depth, bid_bands, bid_band_count, out); }
+    uint32_t ask_curve(DepthPoint* out) const { return curve(asks, ask_depth, ask_bands, ask_band_count, out); }
+
+    // Taking `quantity` off the asks (a buy) or the bids (a sell).
+    DepthFill buy(double quantity) const {
+        DepthPoint points[CURVE];
+        return fill(points, ask_curve(points), quantity);
+    }
+    DepthFill sell(double quantity) const {
+        DepthPoint points[CURVE];
+        return fill(points, bid_curve(points), quantity);
+    }
+
+    static uint32_t curve(const PriceLevel* levels, uint32_t depth, const DepthPoint* bands, uint32_t band_count,
+                          DepthPoint* out) {
+        DepthPoint total;
+        for (uint32_t i = 0; i < depth; ++i) {
+            total.quantity += levels[i].quantity.to_double();
+            total.notional += levels[i].price.to_double() * levels[i].quantity.to_double();
+            out[i] = total;
+        }
+        for (uint32_t b = 0; b < band_count; ++b) out[depth + b] = bands[b];
+        return depth + band_count;
+    }
+
+    // Binary search over the curve.
+    static DepthFill fill(const DepthPoint* curve, uint32_t points, double quantity) {
+        DepthFill result;
+        if (points == 0 || quantity <= 0) return result;
+        const DepthPoint* end = curve + points;
+        const DepthPoint* at = lower_bound(curve, end, quantity,
+                                           [](const DepthPoint& point, double q) { return point.quantity < q; });
+        if (at == end) {
+            result.quantity = end[-1].quantity;
+            result.notional = end[-1].notional;
+            return result;
+        }
+        DepthPoint before = at == curve ? DepthPoint{} : at[-1];
+        result.quantity = quantity;
+        result.notional = before.notional + (quantity - before.quantity) * (at->notional - before.notional) /
+                                                (at->quantity - before.quantity);
+        result.complete = true;
+        return result;
+    }
+
+    bool has_quotes() const { return bid_depth > 0 && ask_depth > 0; }
+    PriceLevel best_bid() const { return bid_depth ? bids[0] : PriceLevel{}; }
+    PriceLevel best_ask() const { return ask_depth ? asks[0] : PriceLevel{}; }
+
+    Price mid_price() const {
+        if (!has_quotes()) return Price{};
+        return Price((bids[0].price.raw + asks[0].price.raw) / 2);
     }
+
+    Price spread() const {
+        if (!has_quotes()) return Price{};
+        return asks[0].price - bids[0].price;
+    }
+
+    int age_seconds() const {
+        auto now = chrono::steady_clock::now().time_since_epoch();
+        return static_cast<int>(chrono::duration_cast<chrono::seconds>(now - chrono::nanoseconds(update_ns)).count());
+    }
+
+    bool is_fresh() const { return update_ns != 0 && age_seconds() < 30; }
 };
 
+// One side of a book. Levels are stored in a power-of-two ring indexed by
+// (tick & MASK), so the window [anchor_tick, anchor_tick + WINDOW_TICKS)
+// can slide with the market without moving any data. An occupancy bitmap
+// lets us find the next best level with a couple of word scans.
+class PriceLevelArray {
+public:
+    static constexpr size_t WINDOW_TICKS = 8192;
+    static constexpr int64_t MASK = WINDOW_TICKS - 1;
+    static constexpr size_t WORDS = WINDOW_TICKS / 64;
+    static constexpr int64_t NO_LEVEL = INT64_MIN;
+
+private:
+    alignas(64) array<int64_t, WINDOW_TICKS> quantities;
+    alignas(64) array<uint64_t, WORDS> occupancy;
+    // Fenwick tree over the occupancy words of the quantity and tick *
+    // quantity resting in each, kept with every level change; a prefix sum
+    // is O(log WORDS) words plus the levels of one partial word, found from
+    // its occupancy bits. Word w lives at index w + 1, and the whole tree
+    // stays in L1. Ticks are absolute, so sliding the window leaves the
+    // sums valid.
+    struct DepthNode {
+        __int128 tick_notional;
+        int64_t quantity;
+    };
+    alignas(64) array<DepthNode, WORDS + 1> depth_tree;
+
+    int64_t anchor_tick = 0;
+    int64_t best = NO_LEVEL;
+    size_t level_count = 0;
+    size_t dropped_levels = 0;
+    bool is_bid;
+
+    bool in_window(int64_t tick) const {
+        return tick >= anchor_tick && tick < anchor_tick + static_cast<int64_t>(WINDOW_TICKS);
+    }
+
+    bool is_better(int64_t a, int64_t b) const {
+        return is_bid ? a > b : a < b;
+    }
+
+    bool occupied(int64_t tick) const {
+        size_t slot = static_cast<size_t>(tick & MASK);
+        return (occupancy[slot >> 6] >> (slot & 63)) & 1ULL;
+    }
+
+    void tree_add(size_t slot, int64_t tick, int64_t delta) {
+        __int128 notional = static_cast<__int128>(tick) * delta;
+        for (size_t i = (slot >> 6) + 1; i <= WORDS; i += i & (~i + 1)) {
+            depth_tree[i].quantity += delta;
+            depth_tree[i].tick_notional += notional;
+        }
+    }
+
+    void evict(int64_t tick) {
+        size_t slot = static_cast<size_t>(tick & MASK);
+        uint64_t bit = 1ULL << (slot & 63);
+        if (occupancy[slot >> 6] & bit) {
+            occupancy[slot >> 6] &= ~bit;
+            tree_add(slot, tick, -quantities[slot]);
+            quantities[slot] = 0;
+            --level_count;
+        }
+    }
+
+    // Highest occupied tick in [lo, from], or NO_LEVEL.
+    int64_t scan_down(int64_t from, int64_t lo) const {
+        while (from >= lo) {
+            size_t slot = static_cast<size_t>(from & MASK);
+            unsigned bit = slot & 63;
+            uint64_t mask = bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1);
+            uint64_t bits = occupancy[slot >> 6] & mask;
+            if (bits) {
+                int64_t candidate = from - (bit - (63 - __builtin_clzll(bits)));
+                return candidate >= lo ? candidate : NO_LEVEL;
+            }
+            from -= bit + 1;
+        }
+        return NO_LEVEL;
+    }
+
+    // Lowest occupied tick in [from, hi], or NO_LEVEL.
+    int64_t scan_up(int64_t from, int64_t hi) const {
+        while (from <= hi) {
+            size_t slot = static_cast<size_t>(from & MASK);
+            unsigned bit = slot & 63;
+            uint64_t bits = occupancy[slot >> 6] & (~0ULL << bit);
+            if (bits) {
+                int64_t candidate = from + (__builtin_ctzll(bits) - bit);
+                return candidate <= hi ? candidate : NO_LEVEL;
+            }
+            from += 64 - bit;
+        }
+        return NO_LEVEL;
+    }
+
+    int64_t next_worse(int64_t tick) const {
+        int64_t window_end = anchor_tick + static_cast<int64_t>(WINDOW_TICKS) - 1;
+        return is_bid ? scan_down(tick - 1, anchor_tick) : scan_up(tick + 1, window_end);
+    }
+
+    void recenter(int64_t tick) {
+        int64_t new_anchor = tick - static_cast<int64_t>(WINDOW_TICKS / 2);
+        int64_t shift = new_anchor - anchor_tick;
+
+        if (level_count == 0 || shift >= static_cast<int64_t>(WINDOW_TICKS) ||
+            -shift >= static_cast<int64_t>(WINDOW_TICKS)) {
+            dropped_levels += level_count;
+            clear();
+        } else if (shift > 0) {
+            size_t before = level_count;
+            for (int64_t t = anchor_tick; t < new_anchor; ++t) evict(t);
+            dropped_levels += before - level_count;
+        } else {
+            size_t before = level_count;
+            int64_t old_end = anchor_tick + static_cast<int64_t>(WINDOW_TICKS);
+            for (int64_t t = new_anchor + static_cast<int64_t>(WINDOW_TICKS); t < old_end; ++t) evict(t);
+            dropped_levels += before - level_count;
+        }
+        anchor_tick = new_anchor;
+
+        if (best != NO_LEVEL && !in_window(best)) {
+            best = NO_LEVEL;
+        }
+    }
+
+public:
+    // Resting quantity and sum of tick * quantity over a span of ticks.
+    struct Depth {
+        int64_t quantity = 0;
+        __int128 tick_notional = 0;
+    };
+
+private:
+    // Slots [0, slot); slot 0 gives nothing.
+    Depth prefix(size_t slot) const {
+        Depth sum;
+        size_t word = slot >> 6;
+        for (size_t i = word; i > 0; i &= i - 1) {
+            sum.quantity += depth_tree[i].quantity;
+            sum.tick_notional += depth_tree[i].tick_notional;
+        }
+        unsigned bit = slot & 63;
+        if (bit == 0) return sum;
+        uint64_t bits = occupancy[word] & ((1ULL << bit) - 1);
+        // Tick of the word's slot 0 in the current window.
+        int64_t word_tick = anchor_tick + static_cast<int64_t>(((word << 6) - static_cast<size_t>(anchor_tick & MASK)) & MASK);
+        while (bits) {
+            unsigned low = __builtin_ctzll(bits);
+            int64_t quantity = quantities[(word << 6) + low];
+            int64_t tick = word_tick + low;
+            if (tick >= anchor_tick + static_cast<int64_t>(WINDOW_TICKS)) tick -= WINDOW_TICKS;
+            sum.quantity += quantity;
+            sum.tick_notional += static_cast<__int128>(tick) * quantity;
+            bits &= bits - 1;
+        }
+        return sum;
+    }
+
+public:
+    explicit PriceLevelArray(bool bid_side) : is_bid(bid_side) {
+        quantities.fill(0);
+        occupancy.fill(0);
+        depth_tree.fill({});
+    }
+
+    // Sets the resting quantity at a tick; zero removes the level.
+    void set_level(int64_t tick, int64_t quantity) {
+        if (!in_window(tick)) {
+            if (quantity <= 0) return;
+            if (best != NO_LEVEL && !is_better(tick, best)) {
+                ++dropped_levels;
+                return;
+            }
+            recenter(tick);
+        }
+
+        size_t slot = static_cast<size_t>(tick & MASK);
+        uint64_t bit = 1ULL << (slot & 63);
+
+        if (quantity > 0) {
+            if (!(occupancy[slot >> 6] & bit)) {
+                occupancy[slot >> 6] |= bit;
+                ++level_count;
+            }
+            tree_add(slot, tick, quantity - quantities[slot]);
+            quantities[slot] = quantity;
+            if (best == NO_LEVEL || is_better(tick, best)) {
+                best = tick;
+            }
+        } else if (occupancy[slot >> 6] & bit) {
+            occupancy[slot >> 6] &= ~bit;
+            tree_add(slot, tick, -quantities[slot]);
+            quantities[slot] = 0;
+            --level_count;
+            if (tick == best) {
+                best = level_count ? next_worse(tick) : NO_LEVEL;
+            }
+        }
+    }
+
+    void clear() {
+        if (level_count) {
+            quantities.fill(0);
+            occupancy.fill(0);
+            depth_tree.fill({});
+        }
+        level_count = 0;
+        best = NO_LEVEL;
+    }
+
+    bool empty() const { return level_count == 0; }
+    size_t size() const { return level_count; }
+    size_t dropped() const { return dropped_levels; }
+    int64_t best_tick() const { return best; }
+
+    // Everything resting from the best level out to each of `count`
+    // limits, which move away from the best; O(log WINDOW_TICKS) each, the
+    // best level's prefix shared. A limit past the window is clipped to it
+    // and ends the list. Returns how many of `out` were filled.
+    size_t depth_to(const int64_t* limits, size_t count, Depth* out) const {
+        if (best == NO_LEVEL) return 0;
+        int64_t window_end = anchor_tick + static_cast<int64_t>(WINDOW_TICKS) - 1;
+        size_t best_slot = static_cast<size_t>(best & MASK);
+        Depth at_best = prefix(is_bid ? best_slot + 1 : best_slot);
+        Depth ring;
+        bool have_ring = false;
+        for (size_t n = 0; n < count; ++n) {
+            int64_t limit = is_bid ? max(limits[n], anchor_tick) : min(limits[n], window_end);
+            if (is_bid ? limit > best : limit < best) {
+                out[n] = {};
+                continue;
+            }
+            size_t limit_slot = static_cast<size_t>(limit & MASK);
+            Depth at_limit = prefix(is_bid ? limit_slot : limit_slot + 1);
+            Depth sum = is_bid ? Depth{at_best.quantity - at_limit.quantity, at_best.tick_notional - at_limit.tick_notional}
+                               : Depth{at_limit.quantity - at_best.quantity, at_limit.tick_notional - at_best.tick_notional};
+            if (is_bid ? limit_slot > best_slot : limit_slot < best_slot) {
+                // The span wraps the ring: add the whole ring back.
+                if (!have_ring) {
+                    ring = prefix(WINDOW_TICKS);
+                    have_ring = true;
+                }
+                sum.quantity += ring.quantity;
+                sum.tick_notional += ring.tick_notional;
+            }
+            out[n] = sum;
+            if (limit != limits[n]) return n + 1;
+        }
+        return count;
+    }
+
+    Depth depth_to(int64_t limit_tick) const {
+        Depth sum;
+        depth_to(&limit_tick, 1, &sum);
+        return sum;
+    }
+
+    int64_t quantity_at(int64_t tick) const {
+        if (!in_window(tick) || !occupied(tick)) return 0;
+        return quantities[static_cast<size_t>(tick & MASK)];
+    }
+
+    // Walks from the best level outward; returns the number of levels visited.
+    // Takes every set bit of an occupancy word before loading the next one,
+    // rather than rescanning from each level.
+    template<typename Fn>
+    size_t for_each_level(size_t n, Fn&& fn) const {
+        size_t count = 0;
+        if (best == NO_LEVEL) return 0;
+        int64_t window_end = anchor_tick + static_cast<int64_t>(WINDOW_TICKS) - 1;
+        int64_t tick = best;
+        while (count < n) {
+            size_t slot = static_cast<size_t>(tick & MASK);
+            unsigned bit = slot & 63;
+            int64_t word_tick = tick - bit;  // tick of bit 0 of this word
+            size_t word_slot = slot - bit;
+            uint64_t bits = occupancy[slot >> 6];
+            if (is_bid) {
+                bits &= bit == 63 ? ~0ULL : ((1ULL << (bit + 1)) - 1);
+                while (bits && count < n) {
+                    unsigned top = 63 - __builtin_clzll(bits);
+                    if (word_tick + top < anchor_tick) return count;
+                    fn(count++, word_tick + top, quantities[word_slot + top]);
+                    bits &= ~(1ULL << top);
+                }
+                tick = word_tick - 1;
+                if (tick < anchor_tick) break;
+            } else {
+                bits &= ~0ULL << bit;
+                while (bits && count < n) {
+                    unsigned low = __builtin_ctzll(bits);
+                    if (word_tick + low > window_end) return count;
+                    fn(count++, word_tick + low, quantities[word_slot + low]);
+                    bits &= bits - 1;
+                }
+                tick = word_tick + 64;
+                if (tick > window_end) break;
+            }
+        }
+        return count;
+    }
+};
+
+// Array-backed L2 book: prices are converted once to integer ticks of the
+// instrument and quantities are kept as fixed-point lots, so an update is an
+// indexed store plus a bitmap flip instead of a tree insert and a string
+// allocation.
+//
+// The level arrays belong to the single feed thread that writes the book.
+// Every other thread reads the BookSnapshot the writer publishes after each
+// message, which never blocks the writer.
 class FastOrderbook {
 private:
-    static constexpr size_t MAX_LEVELS = 1000;
-    static constexpr size_t CACHE_LINE_SIZE = 64;
-    
-    alignas(CACHE_LINE_SIZE) array<double, MAX_LEVELS> bid_prices;
-    alignas(CACHE_LINE_SIZE) array<double, MAX_LEVELS> bid_quantities;
-    alignas(CACHE_LINE_SIZE) array<double, MAX_LEVELS> ask_prices;
-    alignas(CACHE_LINE_SIZE) array<double, MAX_LEVELS> ask_quantities;
-    
-    atomic<size_t> bid_count{0};
-    atomic<size_t> ask_count{0};
-    
-    static thread_local vector<char> string_buffer;
-    
+    InstrumentSpec instrument;
+    PriceLevelArray bids{true};
+    PriceLevelArray asks{false};
+    SeqLock<BookSnapshot> published;
+
+    size_t export_levels(const PriceLevelArray& side, size_t n, PriceLevel* out) const {
+        return side.for_each_level(n, [&](size_t i, int64_t t, int64_t qty) {
+            out[i] = {instrument.from_ticks(t), Qty(qty)};
+        });
+    }
+
+    // Depth within each band of the side's best price that reaches past
+    // the published levels. Returns the bands written.
+    uint32_t export_bands(const PriceLevelArray& side, bool is_bid, const PriceLevel* levels, size_t depth,
+                          DepthPoint* out) const;
+
 public:
-    FastOrderbook() {
-        fill(bid_prices.begin(), bid_prices.end(), 0.0);
-        fill(ask_prices.begin(), ask_prices.end(), DBL_MAX);
-    }
-    
-    bool insert_bid(double price, double quantity) {
-        size_t count = bid_count.load(memory_order_relaxed);
-        if (count >= MAX_LEVELS) return false;
-        
-        bid_prices[count] = price;
-        bid_quantities[count] = quantity;
-        bid_count.store(count + 1, memory_order_release);
-        return true;
+    explicit FastOrderbook(const InstrumentSpec& spec = InstrumentSpec{})
+        : instrument(spec) {}
+
+    void apply_bid(Price price, Qty quantity) {
+        bids.set_level(instrument.to_ticks(price), quantity.raw);
     }
-    
-    bool insert_ask(double price, double quantity) {
-        size_t count = ask_count.load(memory_order_relaxed);
-        if (count >= MAX_LEVELS) return false;
-        
-        ask_prices[count] = price;
-        ask_quantities[count] = quantity;
-        ask_count.store(count + 1, memory_order_release);
-        return true;
+
+    void apply_ask(Price price, Qty quantity) {
+        asks.set_level(instrument.to_ticks(price), quantity.raw);
+    }
+
+    void clear() {
+        bids.clear();
+        asks.clear();
+    }
+
+    // Ticks index the ladders, so a new tick size starts an empty book.
+    void set_spec(const InstrumentSpec& spec) {
+        instrument = spec;
+        clear();
     }
-    
-    pair<double, double> get_best_bid() const {
-        size_t count = bid_count.load(memory_order_acquire);
-        if (count == 0) return make_pair(0.0, 0.0);
-        return make_pair(bid_prices[0], bid_quantities[0]);
-    }
-    
-    pair<double, double> get_best_ask() const {
-        size_t count = ask_count.load(memory_order_acquire);
-        if (count == 0) return make_pair(0.0, 0.0);
-        return make_pair(ask_prices[0], ask_quantities[0]);
-    }
-    
-    double calculate_spread() const {
-        auto best_bid = get_best_bid();
-        auto best_ask = get_best_ask();
-        if (best_bid.first == 0.0 || best_ask.first == 0.0) return 0.0;
-        return best_ask.first - best_bid.first;
-    }
-    
+
+    bool has_quotes() const {
+        return !bids.empty() && !asks.empty();
+    }
+
+    PriceLevel get_best_bid() const {
+        if (bids.empty()) return {};
+        int64_t t = bids.best_tick();
+        return {instrument.from_ticks(t), Qty(bids.quantity_at(t))};
+    }
+
+    PriceLevel get_best_ask() const {
+        if (asks.empty()) return {};
+        int64_t t = asks.best_tick();
+        return {instrument.from_ticks(t), Qty(asks.quantity_at(t))};
+    }
+
+    Price mid_price() const {
+        if (!has_quotes()) return Price{};
+        return Price((instrument.from_ticks(bids.best_tick()).raw +
+                      instrument.from_ticks(asks.best_tick()).raw) / 2);
+    }
+
+    Price calculate_spread() const {
+        if (!has_quotes()) return Price{};
+        return instrument.from_ticks(asks.best_tick() - bids.best_tick());
+    }
+
+    size_t top_bids(size_t n, PriceLevel* out) const { return export_levels(bids, n, out); }
+    size_t top_asks(size_t n, PriceLevel* out) const { return export_levels(asks, n, out); }
+
     string serialize_top_levels(size_t levels) const {
         string result;
-        result.reserve(levels * 50); 
-        
-        size_t bid_cnt = min(levels, bid_count.load(memory_order_acquire));
-        size_t ask_cnt = min(levels, ask_count.load(memory_order_acquire));
-        
+        result.reserve(levels * 50);
+
+        vector<PriceLevel> top(levels);
+        size_t bid_cnt = top_bids(levels, top.data());
         for (size_t i = 0; i < bid_cnt; ++i) {
-            result += "B:" + to_string(bid_prices[i]) + "@" + to_string(bid_quantities[i]) + ";";
+            result += "B:" + to_string(top[i].price.to_double()) + "@" + to_string(top[i].quantity.to_double()) + ";";
         }
+        size_t ask_cnt = top_asks(levels, top.data());
         for (size_t i = 0; i < ask_cnt; ++i) {
-            result += "A:" + to_string(ask_prices[i]) + "@" + to_string(ask_quantities[i]) + ";";
+            result += "A:" + to_string(top[i].price.to_double()) + "@" + to_string(top[i].quantity.to_double()) + ";";
         }
-        
+
         return result;
     }
-    
-    void clear() {
-        bid_count.store(0, memory_order_relaxed);
-        ask_count.store(0, memory_order_relaxed);
-    }
-    
-    size_t get_bid_count() const {
-        return bid_count.load(memory_order_acquire);
-    }
-    
-    size_t get_ask_count() const {
-        return ask_count.load(memory_order_acquire);
+
+    // Writer side: make the current top of book visible to readers.
+    void publish() {
+        BookSnapshot snap;
+        snap.bid_depth = static_cast<uint32_t>(top_bids(BookSnapshot::DEPTH, snap.bids));
+        snap.ask_depth = static_cast<uint32_t>(top_asks(BookSnapshot::DEPTH, snap.asks));
+        snap.bid_band_count = export_bands(bids, true, snap.bids, snap.bid_depth, snap.bid_bands);
+        snap.ask_band_count = export_bands(asks, false, snap.asks, snap.ask_depth, snap.ask_bands);
+        snap.bid_count = static_cast<uint32_t>(bids.size());
+        snap.ask_count = static_cast<uint32_t>(asks.size());
+        snap.update_ns = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+        published.store(snap);
     }
+
+    // Reader side: lock-free, consistent copy of the last published state.
+    BookSnapshot snapshot() const { return published.load(); }
+    uint64_t snapshot_version() const { return published.version(); }
+
+    size_t get_bid_count() const { return bids.size(); }
+    size_t get_ask_count() const { return asks.size(); }
+    size_t get_dropped_count() const { return bids.dropped() + asks.dropped(); }
+    const InstrumentSpec& spec() const { return instrument; }
+
+    static void benchmark_against_map();
+    static void benchmark_reader_contention();
+    static void benchmark_depth_queries();
+};
+
+// One side of a trade across two books, with quantities in the underlying
+// (book quantity times multiplier) and prices scaled by price_factor: fees,
+// and carry or funding when a leg stands in for another.
+struct ExecutionLeg {
+    const BookSnapshot& book;
+    double multiplier = 1.0;
+    double price_factor = 1.0;
+};
+
+// The size a taker can do right now buying one book's asks and selling
+// another's bids; cost and proceeds include the legs' price factors.
+struct ExecutableEdge {
+    double quantity = 0.0;
+    double cost = 0.0;
+    double proceeds = 0.0;
+
+    double profit() const { return proceeds - cost; }
+    double edge() const { return cost > 0 ? proceeds / cost - 1.0 : 0.0; }
 };
 
-thread_local vector<char> FastOrderbook::string_buffer;
+// Walks both depth curves together, taking each next slice while its own
+// edge (sell price over buy price, less one) stays above min_edge.
+ExecutableEdge executable_edge(const ExecutionLeg& buy, const ExecutionLeg& sell, double min_edge = 0.0);
 
 #endif
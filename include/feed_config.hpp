@@ -0,0 +1,71 @@
+#ifndef FEED_CONFIG_HPP
+#define FEED_CONFIG_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+struct FeedConfig {
+    // Number of ConnectionPool I/O threads the feed sessions are spread
+    // over; capped at one per session.
+    size_t reactor_shards = 1;
+    // Keep a second, connected but unsubscribed socket per session that is
+    // promoted as soon as the active one drops.
+    bool warm_standby = true;
+    // Subscribe both links of every session and merge them first-arrival-
+    // wins by update ID. Replaces the standby when set.
+    bool ab_arbitration = false;
+    // Also subscribe each venue's top-of-book channel and feed it into the
+    // instrument's BboSlot alongside the depth book's own top.
+    bool bbo_channels = false;
+    // Also subscribe each perpetual's funding / mark-price channel and keep
+    // the instrument's FundingSlot current.
+    bool funding_channels = false;
+    // Hand decoded levels to a dedicated book thread over per-book SPSC
+    // rings instead of applying them on the I/O thread.
+    bool book_pipeline = false;
+    // Reconnect delay is drawn uniformly from [0, min(max, base * 2^attempt)].
+    int reconnect_base_ms = 250;
+    int reconnect_max_ms = 30000;
+};
+
+// Point-in-time health of one feed session, for reporting.
+struct FeedHealth {
+    string session;
+    bool up = false;
+    bool standby_ready = false;
+    uint64_t outages = 0;
+    uint64_t downtime_ns = 0;
+    uint64_t last_outage_ns = 0;
+    uint64_t reconnects = 0;
+    uint64_t failovers = 0;
+
+    bool ab_arbitration = false;
+    uint64_t leg_wins[2] = {0, 0};
+    uint64_t leg_lead_ns[2] = {0, 0};
+    uint64_t leg_lead_samples[2] = {0, 0};
+    uint64_t duplicates = 0;
+
+    // Summed over the session's books.
+    uint64_t sequence_gaps = 0;
+    uint64_t resyncs = 0;
+    uint64_t resync_ns_total = 0;
+    uint64_t resync_ns_max = 0;
+    uint64_t checksum_failures = 0;
+
+    // Which source published each best bid/offer change first
+    // (indexed by BboSource), and by how much.
+    bool bbo_channels = false;
+    uint64_t bbo_wins[2] = {0, 0};
+    uint64_t bbo_lead_ns[2] = {0, 0};
+    uint64_t bbo_lead_samples[2] = {0, 0};
+
+    // Funding-channel messages applied, and how many moved the rate.
+    bool funding_channels = false;
+    uint64_t funding_updates = 0;
+    uint64_t funding_rate_changes = 0;
+};
+
+#endif
@@ -0,0 +1,375 @@
+#ifndef FEED_DECODER_HPP
+#define FEED_DECODER_HPP
+
+#include <string_view>
+#include <cstdint>
+#include "fast_json_parser.hpp"
+#include "instrument_registry.hpp"
+
+using namespace std;
+
+enum class Channel : uint8_t { Depth, Snapshot, Funding };
+
+// Where a venue puts its depth fields relative to the top-level object.
+enum class Envelope : uint8_t {
+    Flat,        // {"b":[..],"a":[..],...}
+    DataObject,  // {...,"data":{"b":[..],"a":[..]}}
+    DataArray    // {...,"data":[{"bids":[..],"asks":[..]}]}
+};
+
+// Wire layout of one venue's depth channel. Every key is a compile-time
+// constant, and an empty key means the venue never sends that field, so its
+// comparison folds away. Root, body and header keys share one namespace;
+// none of the venues reuses a name across them.
+
+// {"stream":"btcusdt@depth","data":{"e":"depthUpdate","E":..,"s":..,"U":..,"u":..,"pu":..,"b":[..],"a":[..]}}
+// {"stream":"btcusdt@bookTicker","data":{"u":..,"s":..,"b":"p","B":"q","a":"p","A":"q"}}
+// Combined streams wrap each event in "data"; since body keys are matched at
+// every level, a raw single-stream event parses the same way.
+struct BinanceDepthLayout {
+    static constexpr Envelope envelope = Envelope::DataObject;
+    static constexpr size_t level_fields = 2;
+    static constexpr bool requires_both_sides = true;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "";
+    static constexpr string_view bids = "b";
+    static constexpr string_view asks = "a";
+    static constexpr string_view first_id = "U";
+    static constexpr string_view last_id = "u";
+    static constexpr string_view prev_id = "pu";
+    static constexpr string_view time = "E";
+    static constexpr string_view symbol = "s";
+    static constexpr string_view event = "e";
+    static constexpr string_view channel = "stream";
+    static constexpr string_view bid_size = "B";
+    static constexpr string_view ask_size = "A";
+    static constexpr string_view cross_sequence = "";
+    static constexpr string_view checksum = "";
+    static constexpr string_view snapshot_key = "";
+    static constexpr string_view snapshot_value = "";
+};
+
+// {"topic":"orderbook.50.BTCUSDT","type":"snapshot|delta","ts":..,"data":{"s":..,"b":[..],"a":[..],"u":..,"seq":..}}
+// orderbook.1 is the same message with at most one level a side.
+struct BybitDepthLayout {
+    static constexpr Envelope envelope = Envelope::DataObject;
+    static constexpr size_t level_fields = 2;
+    static constexpr bool requires_both_sides = true;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "";
+    static constexpr string_view bids = "b";
+    static constexpr string_view asks = "a";
+    static constexpr string_view first_id = "";
+    static constexpr string_view last_id = "u";
+    static constexpr string_view prev_id = "";
+    static constexpr string_view time = "ts";
+    static constexpr string_view symbol = "s";
+    static constexpr string_view event = "op";
+    static constexpr string_view channel = "topic";
+    static constexpr string_view bid_size = "";
+    static constexpr string_view ask_size = "";
+    static constexpr string_view cross_sequence = "seq";
+    static constexpr string_view checksum = "";
+    static constexpr string_view snapshot_key = "type";
+    static constexpr string_view snapshot_value = "snapshot";
+};
+
+// {"arg":{"channel":"books","instId":..},"action":"snapshot|update",
+//  "data":[{"asks":[..],"bids":[..],"ts":"..","checksum":..,"seqId":..,"prevSeqId":..}]}
+// Only the first entry of "data" is read; the books channel never sends
+// more than one per message. bbo-tbt is the same without action or checksum.
+struct OkxDepthLayout {
+    static constexpr Envelope envelope = Envelope::DataArray;
+    static constexpr size_t level_fields = 4;
+    static constexpr bool requires_both_sides = false;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "arg";
+    static constexpr string_view bids = "bids";
+    static constexpr string_view asks = "asks";
+    static constexpr string_view first_id = "";
+    static constexpr string_view last_id = "seqId";
+    static constexpr string_view prev_id = "prevSeqId";
+    static constexpr string_view time = "ts";
+    static constexpr string_view symbol = "instId";
+    static constexpr string_view event = "event";
+    static constexpr string_view channel = "channel";
+    static constexpr string_view bid_size = "";
+    static constexpr string_view ask_size = "";
+    static constexpr string_view cross_sequence = "";
+    static constexpr string_view checksum = "checksum";
+    static constexpr string_view snapshot_key = "action";
+    static constexpr string_view snapshot_value = "snapshot";
+};
+
+// REST depth snapshot used to seed diff streams:
+// {"lastUpdateId":..,"bids":[["p","q"],..],"asks":[..]} (futures adds "E" and "T")
+struct BinanceRestSnapshotLayout {
+    static constexpr Envelope envelope = Envelope::Flat;
+    static constexpr size_t level_fields = 2;
+    static constexpr bool requires_both_sides = true;
+
+    static constexpr string_view body = "";
+    static constexpr string_view header = "";
+    static constexpr string_view bids = "bids";
+    static constexpr string_view asks = "asks";
+    static constexpr string_view first_id = "";
+    static constexpr string_view last_id = "lastUpdateId";
+    static constexpr string_view prev_id = "";
+    static constexpr string_view time = "E";
+    static constexpr string_view symbol = "";
+    static constexpr string_view event = "";
+    static constexpr string_view channel = "";
+    static constexpr string_view bid_size = "";
+    static constexpr string_view ask_size = "";
+    static constexpr string_view cross_sequence = "";
+    static constexpr string_view checksum = "";
+    static constexpr string_view snapshot_key = "";
+    static constexpr string_view snapshot_value = "";
+};
+
+// Single-pass decoder generated from a layout. There is no runtime format
+// detection: every key test is against a constant, and the envelope walk is
+// chosen at compile time.
+template<typename Layout>
+class DepthDecoder {
+private:
+    static bool key_is(string_view key, string_view expected) {
+        return !expected.empty() && key == expected;
+    }
+
+    static bool member(JsonCursor& c, string_view key, DepthMessage& out, string_view& marker) {
+        if (key_is(key, Layout::bids)) return c.value_span(out.bids);
+        if (key_is(key, Layout::asks)) return c.value_span(out.asks);
+        if (key_is(key, Layout::first_id)) return c.int_value(out.first_update_id);
+        if (key_is(key, Layout::last_id)) return c.int_value(out.last_update_id);
+        if (key_is(key, Layout::prev_id)) return c.int_value(out.prev_update_id);
+        if (key_is(key, Layout::time)) return c.int_value(out.event_time_ms);
+        if (key_is(key, Layout::symbol)) return c.string_token(out.symbol);
+        if (key_is(key, Layout::channel)) return c.string_token(out.channel);
+        if (key_is(key, Layout::bid_size)) return c.scalar_token(out.bid_size);
+        if (key_is(key, Layout::ask_size)) return c.scalar_token(out.ask_size);
+        if (key_is(key, Layout::cross_sequence)) return c.int_value(out.cross_sequence);
+        if (key_is(key, Layout::snapshot_key)) return c.string_token(marker);
+        if (key_is(key, Layout::event)) return c.string_token(out.event);
+        if (key_is(key, Layout::checksum)) {
+            out.has_checksum = true;
+            return c.int_value(out.checksum);
+        }
+        if (key_is(key, Layout::header)) return object(c, out, marker);
+        if (key_is(key, Layout::body)) return body(c, out, marker);
+        return c.skip_value();
+    }
+
+    static bool object(JsonCursor& c, DepthMessage& out, string_view& marker) {
+        return c.for_each_member([&](string_view key) { return member(c, key, out, marker); });
+    }
+
+    static bool body(JsonCursor& c, DepthMessage& out, string_view& marker) {
+        if constexpr (Layout::envelope == Envelope::DataObject) {
+            // Control replies reuse "data" for non-objects; they carry no levels.
+            if (!c.peek('{')) return c.skip_value();
+            return object(c, out, marker);
+        } else if constexpr (Layout::envelope == Envelope::DataArray) {
+            if (!c.consume('[')) return false;
+            if (c.consume(']')) return true;
+            if (!object(c, out, marker)) return false;
+            while (c.consume(',')) {
+                if (!c.skip_value()) return false;
+            }
+            return c.consume(']');
+        } else {
+            return c.skip_value();
+        }
+    }
+
+public:
+    using layout = Layout;
+
+    static bool decode(const char* data, size_t length, DepthMessage& out) {
+        out = DepthMessage{};
+        string_view marker;
+        JsonCursor c(data, data + length);
+        bool ok = object(c, out, marker);
+        if constexpr (!Layout::snapshot_key.empty()) {
+            out.is_snapshot = marker == Layout::snapshot_value;
+        }
+        if constexpr (Layout::requires_both_sides) {
+            return ok && !out.bids.empty() && !out.asks.empty();
+        } else {
+            return ok && out.has_levels();
+        }
+    }
+
+    template<typename Sink>
+    static bool apply(const DepthMessage& message, Sink& sink) {
+        return FastJsonParser::apply_levels<Layout::level_fields>(message, sink);
+    }
+
+    // A top-of-book channel message. Where the layout names size keys the
+    // touch is sent as scalars (the bid/ask spans are quoted prices);
+    // otherwise it is a book of at most one level a side.
+    template<typename Sink>
+    static bool apply_top(const DepthMessage& message, Sink& sink) {
+        if constexpr (!Layout::bid_size.empty()) {
+            int64_t bid, bid_qty, ask, ask_qty;
+            string_view bid_text = unquote(message.bids);
+            string_view ask_text = unquote(message.asks);
+            if (!parse_fixed_point_pair(bid_text.data(), bid_text.size(), message.bid_size.data(),
+                                        message.bid_size.size(), bid, bid_qty) ||
+                !parse_fixed_point_pair(ask_text.data(), ask_text.size(), message.ask_size.data(),
+                                        message.ask_size.size(), ask, ask_qty)) {
+                return false;
+            }
+            sink.apply_bid(Price(bid), Qty(bid_qty));
+            sink.apply_ask(Price(ask), Qty(ask_qty));
+            return true;
+        } else {
+            return apply(message, sink);
+        }
+    }
+
+private:
+    static string_view unquote(string_view text) {
+        if (text.size() >= 2 && text.front() == '"') return text.substr(1, text.size() - 2);
+        return text;
+    }
+};
+
+// Normalized view of one funding / mark-price message. Values stay as text
+// spans; a field the message does not carry is empty (Bybit ticker deltas
+// only resend what changed).
+struct FundingMessage {
+    string_view symbol;
+    string_view event;
+    string_view channel;
+    string_view mark_price;
+    string_view index_price;
+    string_view funding_rate;
+    int64_t next_funding_ms = 0;
+    int64_t event_time_ms = 0;
+
+    bool has_values() const { return !mark_price.empty() || !funding_rate.empty(); }
+};
+
+// Wire layout of one venue's funding channel, on the same terms as the depth
+// layouts above.
+
+// {"stream":"btcusdt@markPrice","data":{"e":"markPriceUpdate","E":..,"s":"BTCUSDT",
+//  "p":"..","i":"..","P":"..","r":"0.00038167","T":1562306400000}}
+struct BinanceFundingLayout {
+    static constexpr Envelope envelope = Envelope::DataObject;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "";
+    static constexpr string_view symbol = "s";
+    static constexpr string_view event = "e";
+    static constexpr string_view channel = "stream";
+    static constexpr string_view mark_price = "p";
+    static constexpr string_view index_price = "i";
+    static constexpr string_view funding_rate = "r";
+    static constexpr string_view next_funding = "T";
+    static constexpr string_view time = "E";
+};
+
+// {"topic":"tickers.BTCUSDT","type":"snapshot|delta","ts":..,
+//  "data":{"symbol":"BTCUSDT","markPrice":"..","indexPrice":"..","fundingRate":"..","nextFundingTime":"..",..}}
+struct BybitFundingLayout {
+    static constexpr Envelope envelope = Envelope::DataObject;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "";
+    static constexpr string_view symbol = "symbol";
+    static constexpr string_view event = "op";
+    static constexpr string_view channel = "topic";
+    static constexpr string_view mark_price = "markPrice";
+    static constexpr string_view index_price = "indexPrice";
+    static constexpr string_view funding_rate = "fundingRate";
+    static constexpr string_view next_funding = "nextFundingTime";
+    static constexpr string_view time = "ts";
+};
+
+// {"arg":{"channel":"funding-rate","instId":..},"data":[{"fundingRate":"..","fundingTime":"..","ts":"..",..}]}
+// {"arg":{"channel":"mark-price","instId":..},"data":[{"markPx":"..","ts":"..",..}]}
+struct OkxFundingLayout {
+    static constexpr Envelope envelope = Envelope::DataArray;
+
+    static constexpr string_view body = "data";
+    static constexpr string_view header = "arg";
+    static constexpr string_view symbol = "instId";
+    static constexpr string_view event = "event";
+    static constexpr string_view channel = "channel";
+    static constexpr string_view mark_price = "markPx";
+    static constexpr string_view index_price = "";
+    static constexpr string_view funding_rate = "fundingRate";
+    static constexpr string_view next_funding = "fundingTime";
+    static constexpr string_view time = "ts";
+};
+
+template<typename Layout>
+class FundingDecoder {
+private:
+    static bool key_is(string_view key, string_view expected) {
+        return !expected.empty() && key == expected;
+    }
+
+    static bool member(JsonCursor& c, string_view key, FundingMessage& out) {
+        if (key_is(key, Layout::symbol)) return c.string_token(out.symbol);
+        if (key_is(key, Layout::channel)) return c.string_token(out.channel);
+        if (key_is(key, Layout::event)) return c.string_token(out.event);
+        if (key_is(key, Layout::mark_price)) return c.scalar_token(out.mark_price);
+        if (key_is(key, Layout::index_price)) return c.scalar_token(out.index_price);
+        if (key_is(key, Layout::funding_rate)) return c.scalar_token(out.funding_rate);
+        if (key_is(key, Layout::next_funding)) return c.int_value(out.next_funding_ms);
+        if (key_is(key, Layout::time)) return c.int_value(out.event_time_ms);
+        if (key_is(key, Layout::header)) return object(c, out);
+        if (key_is(key, Layout::body)) return body(c, out);
+        return c.skip_value();
+    }
+
+    static bool object(JsonCursor& c, FundingMessage& out) {
+        return c.for_each_member([&](string_view key) { return member(c, key, out); });
+    }
+
+    static bool body(JsonCursor& c, FundingMessage& out) {
+        if constexpr (Layout::envelope == Envelope::DataObject) {
+            if (!c.peek('{')) return c.skip_value();
+            return object(c, out);
+        } else {
+            if (!c.consume('[')) return false;
+            if (c.consume(']')) return true;
+            if (!object(c, out)) return false;
+            while (c.consume(',')) {
+                if (!c.skip_value()) return false;
+            }
+            return c.consume(']');
+        }
+    }
+
+public:
+    using layout = Layout;
+
+    static bool decode(const char* data, size_t length, FundingMessage& out) {
+        out = FundingMessage{};
+        JsonCursor c(data, data + length);
+        return object(c, out) && out.has_values();
+    }
+};
+
+// Compile-time binding of (exchange, channel) to a decoder. Each feed
+// handler names its specialization directly; an unsupported pair has no
+// definition and fails to compile.
+template<Exchange E, Channel C>
+struct Decoder;
+
+template<> struct Decoder<Exchange::Binance, Channel::Depth> : DepthDecoder<BinanceDepthLayout> {};
+template<> struct Decoder<Exchange::Bybit, Channel::Depth> : DepthDecoder<BybitDepthLayout> {};
+template<> struct Decoder<Exchange::OKX, Channel::Depth> : DepthDecoder<OkxDepthLayout> {};
+template<> struct Decoder<Exchange::Binance, Channel::Snapshot> : DepthDecoder<BinanceRestSnapshotLayout> {};
+template<> struct Decoder<Exchange::Binance, Channel::Funding> : FundingDecoder<BinanceFundingLayout> {};
+template<> struct Decoder<Exchange::Bybit, Channel::Funding> : FundingDecoder<BybitFundingLayout> {};
+template<> struct Decoder<Exchange::OKX, Channel::Funding> : FundingDecoder<OkxFundingLayout> {};
+
+#endif
@@ -0,0 +1,700 @@
+#ifndef FEED_HANDLER_HPP
+#define FEED_HANDLER_HPP
+
+#include <websocketpp/config/asio_client.hpp>
+#include <websocketpp/client.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <charconv>
+#include "feed_decoder.hpp"
+#include "book_storage.hpp"
+#include "feed_config.hpp"
+#include "connection_pool.hpp"
+#include "leg_arbiter.hpp"
+#include "sequence_tracker.hpp"
+#include "book_pipeline.hpp"
+#include "snapshot_fetcher.hpp"
+#include "performance_monitor.hpp"
+
+using namespace std;
+
+// Venue wiring for FeedHandler. A session is one connection carrying every
+// instrument of one market; the traits say where it connects and which
+// frames subscribe it. `leg` is 0 or 1 and lets the second connection of a
+// session use a different edge where the venue has one. `bbo` adds the
+// venue's top-of-book channel next to each depth stream, and is_ticker
+// tells its messages apart by channel name; `funding` and is_funding do the
+// same for the funding / mark-price channel of each perpetual. Decoding is
+// picked from `exchange` at compile time.
+//
+// `rest_snapshot` says how a book comes back after a sequence gap: from a
+// REST snapshot at snapshot_host/snapshot_target, or from the snapshot the
+// venue sends in-band when resync_messages resubscribe the instrument.
+struct BinanceFeed {
+    static constexpr Exchange exchange = Exchange::Binance;
+    static constexpr bool rest_snapshot = true;
+    // Combined streams name every channel in the URL, so nothing is sent on open.
+    static string uri(MarketType market, const vector<const InstrumentInfo*>& instruments, int leg,
+                      bool bbo, bool funding);
+    static vector<string> subscribe_messages(const vector<const InstrumentInfo*>& instruments, bool bbo,
+                                             bool funding);
+    static bool is_ticker(string_view channel);
+    static bool is_funding(string_view channel);
+    static string snapshot_host(MarketType market);
+    static string snapshot_target(const InstrumentInfo& info);
+};
+
+struct BybitFeed {
+    static constexpr Exchange exchange = Exchange::Bybit;
+    static constexpr bool rest_snapshot = false;
+    static string uri(MarketType market, const vector<const InstrumentInfo*>& instruments, int leg,
+                      bool bbo, bool funding);
+    static vector<string> subscribe_messages(const vector<const InstrumentInfo*>& instruments, bool bbo,
+                                             bool funding);
+    static bool is_ticker(string_view channel);
+    static bool is_funding(string_view channel);
+    static vector<string> resync_messages(const InstrumentInfo& info);
+};
+
+struct OkxFeed {
+    static constexpr Exchange exchange = Exchange::OKX;
+    static constexpr bool rest_snapshot = false;
+    static string uri(MarketType market, const vector<const InstrumentInfo*>& instruments, int leg,
+                      bool bbo, bool funding);
+    static vector<string> subscribe_messages(const vector<const InstrumentInfo*>& instruments, bool bbo,
+                                             bool funding);
+    static bool is_ticker(string_view channel);
+    static bool is_funding(string_view channel);
+    static vector<string> resync_messages(const InstrumentInfo& info);
+};
+
+// "[BINANCE BTC SPOT]"
+string feed_tag(const InstrumentInfo& info);
+// "[BINANCE SPOT]"
+string session_tag(Exchange exchange, MarketType market);
+// Whether the instrument's metadata says it settles funding.
+bool is_perpetual(const InstrumentInfo& info);
+
+// What FeedReactor needs from a handler regardless of venue.
+class FeedConnector {
+public:
+    virtual ~FeedConnector() = default;
+    virtual void start() = 0;
+    virtual size_t stream_count() const = 0;
+    // Safe to call from any thread.
+    virtual void collect_health(vector<FeedHealth>& out) const = 0;
+};
+
+// Owns a set of depth streams on one exchange: connection, subscription,
+// decode and book apply all happen here, run to completion on whichever
+// thread runs the io_service it was given. Streams of the same market share
+// one session (one socket and TLS handshake); each message is routed to its
+// book by the symbol it carries.
+//
+// Each session is supervised. A dropped link is redialled after a jittered
+// exponential backoff, and with warm_standby a second link is kept connected
+// but unsubscribed; when the active link drops the standby is promoted on the
+// spot, the session's books are cleared and the subscription resent, so the
+// venue's snapshot rebuilds them.
+//
+// With ab_arbitration both links are subscribed legs (A and B) feeding the
+// same books, and each stream's LegArbiter applies whichever copy of an
+// update arrives first. The session is only down when both legs are.
+//
+// Every book runs its updates through a SequenceTracker. A gap parks that
+// one book until a snapshot arrives (REST on Binance, fetched asynchronously
+// on this same io_service; a resubscribe elsewhere) while the rest of the
+// session keeps flowing. OKX books are also checked against the CRC-32
+// checksum each message carries, and resubscribed on a mismatch.
+//
+// With bbo_channels the venue's top-of-book channel rides the same session.
+// Its messages skip the depth machinery and go straight to the instrument's
+// BboSlot, which every applied depth update also offers its top to; the
+// slot keeps whichever is newer by the venue's book sequence.
+//
+// With funding_channels each perpetual's funding / mark-price channel rides
+// its session too, into the instrument's FundingSlot.
+//
+// Decoded levels reach the book through its BookLane: applied right here,
+// or with a BookPipeline queued to the book thread, which then publishes,
+// offers the top and verifies the checksum.
+template<typename Traits>
+class FeedHandler : public FeedConnector {
+private:
+    using client = websocketpp::client<websocketpp::config::asio_tls_client>;
+    using BookDecoder = Decoder<Traits::exchange, Channel::Depth>;
+    using FundingMessageDecoder = Decoder<Traits::exchange, Channel::Funding>;
+
+    static constexpr int NO_LINK = -1;
+    // A resync that has produced no snapshot after this long is asked for again.
+    static constexpr int64_t RESYNC_RETRY_NS = 5000000000LL;
+    static constexpr long SNAPSHOT_RETRY_MS = 1000;
+
+    struct Stream {
+        const InstrumentInfo* info;
+        string tag;
+        unique_ptr<LegArbiter> arbiter;
+        unique_ptr<SequenceTracker> sequence;
+        unique_ptr<BookLane> lane;
+        BboSlot* bbo;
+        FundingSlot* funding;
+        TopOfBook ticker;
+        bool snapshot_pending = false;
+        int64_t resync_requested_ns = 0;
+    };
+
+    // One socket of a session. `generation` tells callbacks from a socket
+    // that has since been replaced apart from the current one.
+    struct Link {
+        websocketpp::connection_hdl hdl;
+        bool open = false;
+        uint64_t generation = 0;
+        int failed_attempts = 0;
+    };
+
+    struct Session {
+        MarketType market;
+        string tag;
+        // Sorted by symbol for routing.
+        vector<Stream> streams;
+
+        Link links[2];
+        int active = NO_LINK;
+        int64_t down_since_ns = 0;
+        // Socket-level counters, registered with the ConnectionPool.
+        ConnectionStats* traffic = nullptr;
+
+        // Written on the reactor thread, read by reporting.
+        atomic<bool> up{false};
+        atomic<bool> standby_ready{false};
+        atomic<uint64_t> outages{0};
+        atomic<uint64_t> downtime_ns{0};
+        atomic<uint64_t> last_outage_ns{0};
+        atomic<uint64_t> failovers{0};
+        atomic<uint64_t> checksum_failures{0};
+        atomic<uint64_t> funding_updates{0};
+        atomic<uint64_t> funding_rate_changes{0};
+
+        Stream* route(string_view symbol) {
+            auto it = lower_bound(streams.begin(), streams.end(), symbol,
+                                  [](const Stream& s, string_view key) { return s.info->symbol < key; });
+            return it != streams.end() && it->info->symbol == symbol ? &*it : nullptr;
+        }
+
+        vector<const InstrumentInfo*> instruments() const {
+            vector<const InstrumentInfo*> out;
+            for (const auto& stream : streams) out.push_back(stream.info);
+            return out;
+        }
+    };
+
+    client endpoint;
+    FeedConfig config;
+    mt19937_64 jitter{random_device{}()};
+    vector<unique_ptr<Session>> sessions;
+
+    static int64_t now_ns() {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t link_count() const { return config.warm_standby || config.ab_arbitration ? 2 : 1; }
+
+    static const char* leg_name(int slot) { return slot == 0 ? "A" : "B"; }
+
+    // Whether messages on this link reach the books.
+    bool feeds(const Session& session, int slot) const {
+        return config.ab_arbitration ? session.links[slot].open : slot == session.active;
+    }
+
+    bool connected(const Session& session) const {
+        for (size_t slot = 0; slot < link_count(); ++slot) {
+            if (feeds(session, static_cast<int>(slot))) return true;
+        }
+        return false;
+    }
+
+    void reset_books(Session& session) {
+        for (auto& stream : session.streams) {
+            stream.lane->reset();
+            stream.arbiter->reset();
+            stream.sequence->reset();
+            stream.resync_requested_ns = 0;
+            stream.ticker.clear();
+            // Diffs are buffered from here on; fetch what they replay onto.
+            if constexpr (Traits::rest_snapshot) request_snapshot(session, stream);
+        }
+    }
+
+    void update_standby(Session& session) {
+        if (config.ab_arbitration) return;
+        bool ready = false;
+        for (size_t slot = 0; slot < link_count(); ++slot) {
+            ready |= static_cast<int>(slot) != session.active && session.links[slot].open;
+        }
+        session.standby_ready = ready;
+    }
+
+    void send(Session& session, int slot, const string& message) {
+        websocketpp::lib::error_code ec;
+        endpoint.send(session.links[slot].hdl, message, websocketpp::frame::opcode::text, ec);
+        if (ec) {
+            session.traffic->errors++;
+            cout << session.tag << " Send error: " << ec.message() << endl;
+        }
+    }
+
+    void subscribe(Session& session, int slot) {
+        for (const auto& message : Traits::subscribe_messages(session.instruments(), config.bbo_channels,
+                                                                   config.funding_channels)) {
+            send(session, slot, message);
+        }
+    }
+
+    // Asks for a fresh snapshot of one book. Only this stream waits for it.
+    void request_snapshot(Session& session, Stream& stream) {
+        stream.resync_requested_ns = now_ns();
+        if constexpr (Traits::rest_snapshot) {
+            if (stream.snapshot_pending) return;
+            stream.snapshot_pending = true;
+            Session* s = &session;
+            Stream* st = &stream;
+            https_get(endpoint.get_io_service(), Traits::snapshot_host(session.market),
+                      Traits::snapshot_target(*stream.info),
+                      [this, s, st](bool ok, string body) { on_rest_snapshot(*s, *st, ok, body); });
+        } else {
+            for (size_t slot = 0; slot < link_count(); ++slot) {
+                if (!feeds(session, static_cast<int>(slot))) continue;
+                for (const auto& message : Traits::resync_messages(*stream.info)) {
+                    send(session, static_cast<int>(slot), message);
+                }
+            }
+        }
+    }
+
+    // The book has just been rebuilt from a snapshot as of `snapshot_id`.
+    // Returns the buffered diffs to replay on top of it.
+    vector<string> snapshot_applied(Stream& stream, int64_t snapshot_id) {
+        int64_t now = now_ns();
+        int64_t gap_started = stream.sequence->gap_started();
+        if (gap_started != 0) {
+            uint64_t took = static_cast<uint64_t>(now - gap_started);
+            PerformanceMonitor::record_operation("book_resync", took);
+            cout << stream.tag << "  Resynced after " << fixed << setprecision(1) << took / 1e6 << " ms" << endl;
+        }
+        stream.resync_requested_ns = 0;
+        return stream.sequence->on_snapshot(snapshot_id, now);
+    }
+
+    // Runs a diff through the book's sequence check and applies it if it
+    // follows on. Returns whether the book changed.
+    bool sequenced_apply(Session& session, Stream& stream, const DepthMessage& depth, const string& payload) {
+        switch (stream.sequence->on_update(depth, payload, now_ns())) {
+            case SequenceTracker::Action::Apply:
+                if (!BookDecoder::apply(depth, *stream.lane)) {
+                    // Part of the update may already be in the lane and the
+                    // tracker has moved past it: empty the book and start over.
+                    cout << stream.tag << " Message parsing error: malformed level, resyncing" << endl;
+                    stream.sequence->invalidate(now_ns());
+                    stream.lane->reset();
+                    request_snapshot(session, stream);
+                    return false;
+                }
+                return true;
+            case SequenceTracker::Action::Resync:
+                cout << stream.tag << "  Sequence gap before update " << depth.last_update_id << ", resyncing" << endl;
+                request_snapshot(session, stream);
+                return false;
+            case SequenceTracker::Action::Drop:
+                if (stream.resync_requested_ns != 0 && now_ns() - stream.resync_requested_ns > RESYNC_RETRY_NS) {
+                    request_snapshot(session, stream);
+                }
+                return false;
+            case SequenceTracker::Action::Buffer:
+                return false;
+        }
+        return false;
+    }
+
+    // A mismatch means the book has diverged from the venue's. The lane
+    // has already emptied it and withdrawn its BBO so nothing trades on it;
+    // it is rebuilt from a fresh snapshot.
+    void on_checksum_mismatch(Session& session, Stream& stream, int64_t sequence) {
+        session.checksum_failures++;
+        cout << stream.tag << "  Checksum mismatch at update " << sequence << ", resyncing" << endl;
+        stream.sequence->invalidate(now_ns());
+        request_snapshot(session, stream);
+    }
+
+    // Ends the message: the book is now as of `sequence` (the venue's book
+    // sequence), and OKX sends the checksum it should have.
+    void book_changed(Session& session, Stream& stream, int64_t sequence, bool has_checksum = false,
+                      int64_t checksum = 0) {
+        stream.lane->commit(sequence, has_checksum, checksum);
+        if (session.down_since_ns != 0) end_outage(session);
+        session.up = true;
+    }
+
+    // A top-of-book channel message. Legs and ordering are settled by the
+    // slot's sequence check, so the arbiter and tracker never see it.
+    void on_ticker(Stream& stream, const DepthMessage& top) {
+        if (top.is_snapshot) stream.ticker.clear();
+        if (!BookDecoder::apply_top(top, stream.ticker)) {
+            cout << stream.tag << " Message parsing error: malformed top of book" << endl;
+            return;
+        }
+        if (stream.ticker.has_quotes()) {
+            stream.lane->ticker(stream.ticker.bid, stream.ticker.ask, top.book_sequence());
+        }
+    }
+
+    // A funding / mark-price channel message. It carries no book sequence;
+    // the slot keeps the latest values, and a new rate is announced on the
+    // event bus for pricing to pick up.
+    void on_funding(Session& session, const string& payload) {
+        FundingMessage message;
+        if (!FundingMessageDecoder::decode(payload.data(), payload.size(), message)) return;
+        Stream* stream = session.route(message.symbol);
+        if (stream == nullptr) return;
+
+        FundingState update;
+        int64_t raw = 0;
+        bool has_mark = !message.mark_price.empty() &&
+                        parse_fixed_point(message.mark_price.data(), message.mark_price.size(), raw);
+        if (has_mark) update.mark_price = Price(raw);
+        bool has_index = !message.index_price.empty() &&
+                         parse_fixed_point(message.index_price.data(), message.index_price.size(), raw);
+        if (has_index) update.index_price = Price(raw);
+        if (!message.funding_rate.empty()) {
+            const char* end = message.funding_rate.data() + message.funding_rate.size();
+            update.has_rate = from_chars(message.funding_rate.data(), end, update.funding_rate).ptr == end;
+        }
+        update.next_funding_ms = message.next_funding_ms;
+        update.event_time_ms = message.event_time_ms;
+
+        session.funding_updates++;
+        if (stream->funding->offer(update, has_mark, has_index, now_ns())) {
+            session.funding_rate_changes++;
+            market_event_bus.publish(MarketEventType::Funding, stream->info->id, BboSource::Ticker, PriceLevel{},
+                                     PriceLevel{}, message.event_time_ms);
+        }
+    }
+
+    // Completion of a REST snapshot fetch, on the reactor thread.
+    void on_rest_snapshot(Session& session, Stream& stream, bool ok, const string& body) {
+        using SnapshotDecoder = Decoder<Traits::exchange, Channel::Snapshot>;
+        stream.snapshot_pending = false;
+
+        DepthMessage snapshot;
+        if (!ok || !SnapshotDecoder::decode(body.data(), body.size(), snapshot)) {
+            cout << stream.tag << "  Snapshot fetch failed, retrying" << endl;
+            Session* s = &session;
+            Stream* st = &stream;
+            endpoint.set_timer(SNAPSHOT_RETRY_MS, [this, s, st](const websocketpp::lib::error_code& ec) {
+                if (ec || st->sequence->is_live() || !connected(*s)) return;
+                request_snapshot(*s, *st);
+            });
+            return;
+        }
+
+        stream.lane->clear();
+        if (!SnapshotDecoder::apply(snapshot, *stream.lane)) {
+            cout << stream.tag << " Snapshot parsing error: malformed level" << endl;
+        }
+        for (const string& payload : snapshot_applied(stream, snapshot.last_update_id)) {
+            DepthMessage depth;
+            if (BookDecoder::decode(payload.data(), payload.size(), depth)) {
+                sequenced_apply(session, stream, depth, payload);
+            }
+        }
+        book_changed(session, stream, stream.sequence->last_applied());
+    }
+
+    // Makes `slot` the link whose messages reach the books. Whatever the
+    // books held came from another socket, so they restart from the
+    // snapshot the fresh subscription triggers.
+    void promote(Session& session, int slot) {
+        session.active = slot;
+        reset_books(session);
+        subscribe(session, slot);
+        update_standby(session);
+    }
+
+    void end_outage(Session& session) {
+        uint64_t duration = static_cast<uint64_t>(now_ns() - session.down_since_ns);
+        session.down_since_ns = 0;
+        session.outages++;
+        session.downtime_ns += duration;
+        session.last_outage_ns = duration;
+        PerformanceMonitor::record_operation("feed_downtime", duration);
+        cout << session.tag << "  Feed restored after " << fixed << setprecision(1) << duration / 1e6 << " ms" << endl;
+    }
+
+    void on_open(Session& session, int slot) {
+        Link& link = session.links[slot];
+        link.failed_attempts = 0;
+        session.traffic->connected = true;
+        if (config.ab_arbitration) {
+            bool other_open = session.links[1 - slot].open;
+            link.open = true;
+            cout << session.tag << "  Leg " << leg_name(slot) << " connected" << endl;
+            // The first leg up starts the books from scratch; a second leg
+            // joins the merge as it is.
+            if (!other_open) reset_books(session);
+            subscribe(session, slot);
+            return;
+        }
+        link.open = true;
+        if (session.active == NO_LINK) {
+            cout << session.tag << "  Connected (" << session.streams.size() << " streams)" << endl;
+            promote(session, slot);
+        } else {
+            cout << session.tag << "  Standby connected" << endl;
+            update_standby(session);
+        }
+    }
+
+    void on_message(Session& session, int slot, client::message_ptr msg) {
+        if (!feeds(session, slot)) return;
+
+        const string& payload = msg->get_payload();
+        session.traffic->on_message(payload.size());
+        DepthMessage depth;
+        if (!BookDecoder::decode(payload.data(), payload.size(), depth)) {
+            // Funding messages have no levels, so they only cost a second
+            // parse once the depth decode has turned them down.
+            if (config.funding_channels && Traits::is_funding(depth.channel)) {
+                on_funding(session, payload);
+                return;
+            }
+            if (!depth.event.empty()) {
+                cout << session.tag << " Event: " << depth.event << endl;
+            }
+            return;
+        }
+
+        Stream* stream = session.route(depth.symbol);
+        if (stream == nullptr) return;
+        if (config.bbo_channels && Traits::is_ticker(depth.channel)) {
+            on_ticker(*stream, depth);
+            return;
+        }
+        if (stream->arbiter->admit(slot, depth.last_update_id, depth.is_snapshot, now_ns()) ==
+            LegArbiter::Verdict::Duplicate) {
+            return;
+        }
+
+        if (depth.is_snapshot) {
+            stream->lane->clear();
+            if (!BookDecoder::apply(depth, *stream->lane)) {
+                cout << stream->tag << " Message parsing error: malformed level" << endl;
+            }
+            snapshot_applied(*stream, depth.last_update_id);
+        } else if (!sequenced_apply(session, *stream, depth, payload)) {
+            return;
+        }
+        book_changed(session, *stream, depth.book_sequence(), depth.has_checksum, depth.checksum);
+    }
+
+    // Fail (never opened) and close (dropped) end up here.
+    void on_lost(Session& session, int slot, const char* what) {
+        Link& link = session.links[slot];
+        bool was_open = link.open;
+        link.open = false;
+        ++link.failed_attempts;
+        session.traffic->errors++;
+        session.traffic->connected = session.links[0].open || session.links[1].open;
+
+        if (config.ab_arbitration) {
+            bool other_open = session.links[1 - slot].open;
+            if (was_open || session.down_since_ns == 0) {
+                cout << session.tag << "  Leg " << leg_name(slot) << ": " << what
+                     << (other_open ? " (other leg carrying)" : "") << endl;
+            }
+            if (!other_open && session.down_since_ns == 0) {
+                session.up = false;
+                session.down_since_ns = now_ns();
+            }
+        } else if (slot == session.active) {
+            cout << session.tag << "  " << what << endl;
+            session.active = NO_LINK;
+            session.up = false;
+            if (session.down_since_ns == 0) session.down_since_ns = now_ns();
+
+            int other = 1 - slot;
+            if (static_cast<size_t>(other) < link_count() && session.links[other].open) {
+                cout << session.tag << "  Failing over to standby" << endl;
+                session.failovers++;
+                promote(session, other);
+            }
+        } else if (session.active != NO_LINK) {
+            cout << session.tag << "  Standby lost, redialling" << endl;
+        } else if (session.down_since_ns == 0) {
+            // Never got up in the first place.
+            cout << session.tag << "  " << what << endl;
+            session.down_since_ns = now_ns();
+        }
+        update_standby(session);
+        schedule_reconnect(session, slot);
+    }
+
+    void schedule_reconnect(Session& session, int slot) {
+        int shift = min(session.links[slot].failed_attempts, 16);
+        int64_t ceiling = min<int64_t>(config.reconnect_max_ms, int64_t(config.reconnect_base_ms) << shift);
+        long delay = static_cast<long>(uniform_int_distribution<int64_t>(0, max<int64_t>(ceiling, 1))(jitter));
+
+        Session* s = &session;
+        endpoint.set_timer(delay, [this, s, slot](const websocketpp::lib::error_code& ec) {
+            if (ec) return;
+            s->traffic->reconnects++;
+            connect(*s, slot);
+        });
+    }
+
+    void connect(Session& session, int slot) {
+        Link& link = session.links[slot];
+        uint64_t generation = ++link.generation;
+
+        websocketpp::lib::error_code ec;
+        client::connection_ptr con =
+            endpoint.get_connection(Traits::uri(session.market, session.instruments(), slot, config.bbo_channels,
+                                                config.funding_channels),
+                                    ec);
+        if (ec) {
+            session.traffic->errors++;
+            cout << session.tag << " Connect error: " << ec.message() << endl;
+            schedule_reconnect(session, slot);
+            return;
+        }
+        link.hdl = con->get_handle();
+
+        Session* s = &session;
+        auto current = [s, slot, generation]() { return s->links[slot].generation == generation; };
+        con->set_open_handler([this, s, slot, current](websocketpp::connection_hdl) {
+            if (current()) on_open(*s, slot);
+        });
+        con->set_message_handler([this, s, slot, current](websocketpp::connection_hdl, client::message_ptr msg) {
+            if (current()) on_message(*s, slot, msg);
+        });
+        con->set_fail_handler([this, s, slot, current](websocketpp::connection_hdl) {
+            if (current()) on_lost(*s, slot, "Connection failed!");
+        });
+        con->set_close_handler([this, s, slot, current](websocketpp::connection_hdl) {
+            if (current()) on_lost(*s, slot, "Connection closed!");
+        });
+
+        endpoint.connect(con);
+    }
+
+public:
+    // Instruments must all belong to Traits::exchange. The io_service is one
+    // of `pool`'s, shared with other handlers; sessions report their traffic
+    // to the pool. With a `pipeline` the books are applied on its thread.
+    FeedHandler(ConnectionPool& pool, boost::asio::io_service& io, const vector<InstrumentId>& instruments,
+                const FeedConfig& feed_config, BookPipeline* pipeline = nullptr)
+        : config(feed_config) {
+        for (size_t m = 0; m < MARKET_TYPE_COUNT; ++m) {
+            auto session = make_unique<Session>();
+            session->market = static_cast<MarketType>(m);
+            session->tag = session_tag(Traits::exchange, session->market);
+            for (InstrumentId id : instruments) {
+                const InstrumentInfo& info = instrument_registry.info(id);
+                if (info.market != session->market) continue;
+                auto lane = make_unique<BookLane>(
+                    instrument_registry.book(id), instrument_registry.bbo(id),
+                    Traits::exchange == Exchange::OKX ? make_unique<OkxBookChecksum>() : nullptr, pipeline,
+                    &market_event_bus, id);
+                if (pipeline) pipeline->add(*lane);
+                session->streams.push_back({&info, feed_tag(info), make_unique<LegArbiter>(),
+                                            make_unique<SequenceTracker>(Traits::rest_snapshot), move(lane),
+                                            &instrument_registry.bbo(id), &instrument_registry.funding(id), {}});
+            }
+            if (session->streams.empty()) continue;
+            sort(session->streams.begin(), session->streams.end(),
+                 [](const Stream& a, const Stream& b) { return a.info->symbol < b.info->symbol; });
+            // Streams no longer move. Mismatches are found on the book's
+            // thread and handled back on this one.
+            for (auto& stream : session->streams) {
+                Session* s = session.get();
+                Stream* st = &stream;
+                stream.lane->on_checksum_mismatch = [this, s, st](int64_t sequence) {
+                    endpoint.get_io_service().post([this, s, st, sequence]() { on_checksum_mismatch(*s, *st, sequence); });
+                };
+            }
+            session->traffic = &pool.track(session->tag);
+            sessions.push_back(move(session));
+        }
+
+        endpoint.set_access_channels(websocketpp::log::alevel::none);
+        endpoint.set_error_channels(websocketpp::log::elevel::none);
+        endpoint.init_asio(&io);
+        endpoint.set_tls_init_handler([](websocketpp::connection_hdl) {
+            return make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::sslv23);
+        });
+    }
+
+    FeedHandler(const FeedHandler&) = delete;
+    FeedHandler& operator=(const FeedHandler&) = delete;
+
+    size_t stream_count() const override {
+        size_t total = 0;
+        for (const auto& session : sessions) total += session->streams.size();
+        return total;
+    }
+
+    // Queues a connect for every link of every session; nothing happens
+    // until the io_service runs.
+    void start() override {
+        for (auto& session : sessions) {
+            const char* mode = config.ab_arbitration ? " (A/B legs)" : config.warm_standby ? " (with standby)" : "";
+            cout << session->tag << "  Connecting " << session->streams.size() << " streams" << mode << "..." << endl;
+            for (size_t slot = 0; slot < link_count(); ++slot) connect(*session, static_cast<int>(slot));
+        }
+    }
+
+    void collect_health(vector<FeedHealth>& out) const override {
+        for (const auto& session : sessions) {
+            FeedHealth health;
+            health.session = session->tag;
+            health.up = session->up;
+            health.standby_ready = session->standby_ready;
+            health.outages = session->outages;
+            health.downtime_ns = session->downtime_ns;
+            health.last_outage_ns = session->last_outage_ns;
+            health.reconnects = session->traffic->reconnects;
+            health.failovers = session->failovers;
+            health.checksum_failures = session->checksum_failures;
+            health.ab_arbitration = config.ab_arbitration;
+            health.bbo_channels = config.bbo_channels;
+            health.funding_channels = config.funding_channels;
+            health.funding_updates = session->funding_updates;
+            health.funding_rate_changes = session->funding_rate_changes;
+            for (const auto& stream : session->streams) {
+                for (int leg = 0; leg < LegArbiter::LEGS; ++leg) {
+                    health.leg_wins[leg] += stream.arbiter->wins[leg];
+                    health.leg_lead_ns[leg] += stream.arbiter->lead_ns[leg];
+                    health.leg_lead_samples[leg] += stream.arbiter->lead_samples[leg];
+                }
+                health.duplicates += stream.arbiter->duplicates;
+                health.sequence_gaps += stream.sequence->gaps;
+                health.resyncs += stream.sequence->recoveries;
+                health.resync_ns_total += stream.sequence->recovery_ns_total;
+                health.resync_ns_max = max<uint64_t>(health.resync_ns_max, stream.sequence->recovery_ns_max);
+                for (size_t source = 0; source < BBO_SOURCE_COUNT; ++source) {
+                    health.bbo_wins[source] += stream.bbo->wins[source];
+                    health.bbo_lead_ns[source] += stream.bbo->lead_ns[source];
+                    health.bbo_lead_samples[source] += stream.bbo->lead_samples[source];
+                }
+            }
+            out.push_back(health);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef FEED_REACTOR_HPP
+#define FEED_REACTOR_HPP
+
+#include <memory>
+#include <vector>
+#include "feed_config.hpp"
+#include "connection_pool.hpp"
+#include "book_pipeline.hpp"
+
+using namespace std;
+
+class FeedConnector;
+
+// Runs every feed connection on the ConnectionPool's I/O threads. Sessions
+// (one per exchange and market) are dealt round-robin over them; each
+// thread gets one FeedHandler per exchange, and every message is decoded
+// on that thread. Books are applied there too, or with book_pipeline on one
+// book thread fed by every I/O thread.
+class FeedReactor {
+private:
+    FeedConfig config;
+    ConnectionPool& pool;
+    size_t shards = 0;
+    // Declared before the handlers, whose lanes it points at, so it outlives them.
+    BookPipeline pipeline;
+    vector<unique_ptr<FeedConnector>> handlers;
+
+public:
+    FeedReactor(ConnectionPool& pool, const FeedConfig& config);
+    ~FeedReactor();
+
+    FeedReactor(const FeedReactor&) = delete;
+    FeedReactor& operator=(const FeedReactor&) = delete;
+
+    // Queues every session's connects; call before the pool's threads run.
+    void start();
+    // Stops the pool's I/O threads, which the handlers run on, then the
+    // book thread.
+    void stop();
+
+    size_t shard_count() const { return shards; }
+
+    vector<FeedHealth> health() const;
+    void print_feed_health() const;
+
+    static void benchmark_reactor_layouts();
+};
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef __SSE4_1__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Prices and quantities are carried as 64-bit integers scaled by 1e8. Eight
+// decimals cover everything Binance, Bybit and OKX put on the wire, so the
+// conversion is exact and compares/adds never touch floating point.
+constexpr int FIXED_POINT_DECIMALS = 8;
+constexpr int64_t FIXED_POINT_SCALE = 100000000;
+
+// Parses a plain decimal such as "67123.45000000" digit by digit. Fraction
+// digits beyond the eighth are truncated. Returns false on anything that is
+// not [-]digits[.digits].
+inline bool parse_fixed_point_scalar(const char* str, size_t length, int64_t& out) {
+    if (length == 0) return false;
+
+    const char* p = str;
+    const char* end = str + length;
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        if (++p == end) return false;
+    }
+
+    int64_t integer_part = 0;
+    const char* digits_start = p;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+        integer_part = integer_part * 10 + (*p - '0');
+        if (integer_part > INT64_MAX / FIXED_POINT_SCALE) return false;
+        ++p;
+    }
+    bool had_integer = p != digits_start;
+
+    int64_t fraction_part = 0;
+    int fraction_digits = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        const char* fraction_start = p;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+            if (fraction_digits < FIXED_POINT_DECIMALS) {
+                fraction_part = fraction_part * 10 + (*p - '0');
+                ++fraction_digits;
+            }
+            ++p;
+        }
+        if (!had_integer && p == fraction_start) return false;
+    } else if (!had_integer) {
+        return false;
+    }
+    if (p != end) return false;
+
+    static constexpr int64_t pow10[FIXED_POINT_DECIMALS + 1] = {
+        100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+    };
+    int64_t value = integer_part * FIXED_POINT_SCALE + fraction_part * pow10[fraction_digits];
+    out = negative ? -value : value;
+    return true;
+}
+
+#ifdef __SSE4_1__
+namespace fixed_point_simd {
+
+// Shuffle that lines a decimal up as 16 digits: the integer part
+// right-aligned in bytes 0-7 and the first 8 fraction digits left-aligned in
+// bytes 8-15, zero filled. Read as one 16-digit number that is exactly the
+// 1e-8 fixed-point value. Indexed by [integer digits][fraction digits].
+struct ShuffleTable {
+    alignas(16) uint8_t masks[FIXED_POINT_DECIMALS + 1][FIXED_POINT_DECIMALS + 1][16];
+};
+
+constexpr ShuffleTable make_shuffle_table() {
+    ShuffleTable table{};
+    for (int int_len = 0; int_len <= FIXED_POINT_DECIMALS; ++int_len) {
+        for (int frac_len = 0; frac_len <= FIXED_POINT_DECIMALS; ++frac_len) {
+            for (int i = 0; i < 8; ++i) {
+                int src = i - (8 - int_len);
+                table.masks[int_len][frac_len][i] = src >= 0 ? static_cast<uint8_t>(src) : 0x80;
+                table.masks[int_len][frac_len][8 + i] = i < frac_len ? static_cast<uint8_t>(int_len + 1 + i) : 0x80;
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr ShuffleTable SHUFFLE = make_shuffle_table();
+
+// 16 bytes from `str`. Read in place only when the caller vouches that 16
+// bytes are in bounds (`padded`); otherwise the string is copied into a
+// zeroed buffer. Bytes beyond `length` are never selected by the shuffle.
+inline __m128i load16(const char* str, size_t length, bool padded) {
+    if (padded) return _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+    alignas(16) char buffer[16] = {};
+    memcpy(buffer, str, length);
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(buffer));
+}
+
+// Validates one decimal from its digit and '.' bitmaps and returns its
+// shuffle mask, or nullptr if it is malformed or needs the scalar path
+// (more than 8 integer digits).
+inline const uint8_t* classify(size_t length, uint32_t digit_mask, uint32_t dot_mask) {
+    uint32_t length_mask = (1u << length) - 1;
+    dot_mask &= length_mask;
+    if (dot_mask & (dot_mask - 1)) return nullptr;
+    if (((digit_mask | dot_mask) & length_mask) != length_mask) return nullptr;
+
+    size_t int_len = dot_mask ? static_cast<size_t>(__builtin_ctz(dot_mask)) : length;
+    size_t frac_len = dot_mask ? length - int_len - 1 : 0;
+    if (int_len > 8 || (int_len == 0 && frac_len == 0)) return nullptr;
+    if (frac_len > FIXED_POINT_DECIMALS) frac_len = FIXED_POINT_DECIMALS;
+    return SHUFFLE.masks[int_len][frac_len];
+}
+
+inline uint32_t digit_bits(__m128i digits) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits)));
+}
+
+inline uint32_t dot_bits(__m128i raw) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(raw, _mm_set1_epi8('.'))));
+}
+
+// 16 digit values -> two 8-digit halves in 32-bit lanes 0 and 1.
+inline __m128i reduce_digits(__m128i digits) {
+    const __m128i tens = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+    const __m128i hundreds = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+    const __m128i ten_thousands = _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1);
+    __m128i pairs = _mm_maddubs_epi16(digits, tens);
+    __m128i quads = _mm_madd_epi16(pairs, hundreds);
+    __m128i packed = _mm_packus_epi32(quads, quads);
+    return _mm_madd_epi16(packed, ten_thousands);
+}
+
+#ifdef __AVX2__
+// Two independent reduce_digits, one per 128-bit lane.
+inline __m256i reduce_digits_x2(__m256i digits) {
+    const __m256i tens = _mm256_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+                                          10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+    const __m256i hundreds = _mm256_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1);
+    const __m256i ten_thousands = _mm256_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1,
+                                                    10000, 1, 10000, 1, 10000, 1, 10000, 1);
+    __m256i pairs = _mm256_maddubs_epi16(digits, tens);
+    __m256i quads = _mm256_madd_epi16(pairs, hundreds);
+    __m256i packed = _mm256_packus_epi32(quads, quads);
+    return _mm256_madd_epi16(packed, ten_thousands);
+}
+#endif
+
+}
+
+// Same contract as parse_fixed_point_scalar. Unsigned values of up to 16
+// characters with at most 8 integer digits are converted in a handful of
+// SSE instructions; anything else takes the scalar path. `padded` says at
+// least 16 bytes from `str` are readable (the string sits inside a larger
+// buffer), which saves copying it out first.
+inline bool parse_fixed_point(const char* str, size_t length, int64_t& out, bool padded = false) {
+    using namespace fixed_point_simd;
+    if (length == 0 || length > 16 || *str == '-') return parse_fixed_point_scalar(str, length, out);
+
+    __m128i raw = load16(str, length, padded);
+    __m128i digits = _mm_sub_epi8(raw, _mm_set1_epi8('0'));
+    const uint8_t* mask = classify(length, digit_bits(digits), dot_bits(raw));
+    if (!mask) return parse_fixed_point_scalar(str, length, out);
+
+    __m128i aligned = _mm_shuffle_epi8(digits, _mm_load_si128(reinterpret_cast<const __m128i*>(mask)));
+    __m128i halves = reduce_digits(aligned);
+    out = static_cast<int64_t>(_mm_cvtsi128_si32(halves)) * FIXED_POINT_SCALE + _mm_extract_epi32(halves, 1);
+    return true;
+}
+
+#ifdef __AVX2__
+// Converts a level's price and quantity together, one per 128-bit lane.
+// `padded` as for parse_fixed_point, holding for both strings.
+inline bool parse_fixed_point_pair(const char* a, size_t a_length, const char* b, size_t b_length,
+                                   int64_t& a_out, int64_t& b_out, bool padded = false) {
+    using namespace fixed_point_simd;
+    if (a_length == 0 || a_length > 16 || *a == '-' || b_length == 0 || b_length > 16 || *b == '-') {
+        return parse_fixed_point(a, a_length, a_out, padded) && parse_fixed_point(b, b_length, b_out, padded);
+    }
+
+    __m256i raw = _mm256_set_m128i(load16(b, b_length, padded), load16(a, a_length, padded));
+    __m256i digits = _mm256_sub_epi8(raw, _mm256_set1_epi8('0'));
+    uint32_t digit_mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits)));
+    uint32_t dot_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(raw, _mm256_set1_epi8('.'))));
+
+    const uint8_t* a_mask = classify(a_length, digit_mask & 0xFFFF, dot_mask & 0xFFFF);
+    const uint8_t* b_mask = classify(b_length, digit_mask >> 16, dot_mask >> 16);
+    if (!a_mask || !b_mask) {
+        return parse_fixed_point(a, a_length, a_out, padded) && parse_fixed_point(b, b_length, b_out, padded);
+    }
+
+    __m256i shuffle = _mm256_set_m128i(_mm_load_si128(reinterpret_cast<const __m128i*>(b_mask)),
+                                       _mm_load_si128(reinterpret_cast<const __m128i*>(a_mask)));
+    __m256i halves = reduce_digits_x2(_mm256_shuffle_epi8(digits, shuffle));
+
+    a_out = static_cast<int64_t>(_mm256_extract_epi32(halves, 0)) * FIXED_POINT_SCALE + _mm256_extract_epi32(halves, 1);
+    b_out = static_cast<int64_t>(_mm256_extract_epi32(halves, 4)) * FIXED_POINT_SCALE + _mm256_extract_epi32(halves, 5);
+    return true;
+}
+#endif
+
+#else
+inline bool parse_fixed_point(const char* str, size_t length, int64_t& out, bool /* padded */ = false) {
+    return parse_fixed_point_scalar(str, length, out);
+}
+#endif
+
+#ifndef __AVX2__
+inline bool parse_fixed_point_pair(const char* a, size_t a_length, const char* b, size_t b_length,
+                                   int64_t& a_out, int64_t& b_out, bool padded = false) {
+    return parse_fixed_point(a, a_length, a_out, padded) && parse_fixed_point(b, b_length, b_out, padded);
+}
+#endif
+
+void benchmark_decimal_parsing();
+
+template<typename Tag>
+struct FixedPoint {
+    int64_t raw = 0;
+
+    constexpr FixedPoint() = default;
+    constexpr explicit FixedPoint(int64_t raw_value) : raw(raw_value) {}
+
+    static FixedPoint from_double(double value) {
+        return FixedPoint(llround(value * FIXED_POINT_SCALE));
+    }
+
+    static FixedPoint parse(const char* str, size_t length) {
+        int64_t value;
+        if (!parse_fixed_point(str, length, value)) {
+            throw invalid_argument("malformed decimal: " + string(str, length));
+        }
+        return FixedPoint(value);
+    }
+
+    static FixedPoint parse(const string& str) {
+        return parse(str.data(), str.size());
+    }
+
+    double to_double() const {
+        return static_cast<double>(raw) / FIXED_POINT_SCALE;
+    }
+
+    bool is_zero() const { return raw == 0; }
+
+    constexpr FixedPoint operator+(FixedPoint other) const { return FixedPoint(raw + other.raw); }
+    constexpr FixedPoint operator-(FixedPoint other) const { return FixedPoint(raw - other.raw); }
+    FixedPoint& operator+=(FixedPoint other) { raw += other.raw; return *this; }
+    FixedPoint& operator-=(FixedPoint other) { raw -= other.raw; return *this; }
+
+    constexpr bool operator==(FixedPoint other) const { return raw == other.raw; }
+    constexpr bool operator!=(FixedPoint other) const { return raw != other.raw; }
+    constexpr bool operator<(FixedPoint other) const { return raw < other.raw; }
+    constexpr bool operator>(FixedPoint other) const { return raw > other.raw; }
+    constexpr bool operator<=(FixedPoint other) const { return raw <= other.raw; }
+    constexpr bool operator>=(FixedPoint other) const { return raw >= other.raw; }
+};
+
+struct PriceTag {};
+struct QtyTag {};
+using Price = FixedPoint<PriceTag>;
+using Qty = FixedPoint<QtyTag>;
+
+// Per-instrument granularity: prices index the book in whole ticks and
+// sizes are only meaningful in whole lots.
+struct InstrumentSpec {
+    Price tick_size{FIXED_POINT_SCALE / 100};
+    Qty lot_size{1};
+
+    static InstrumentSpec make(const char* tick, const char* lot) {
+        InstrumentSpec spec;
+        spec.tick_size = Price::parse(tick, char_traits<char>::length(tick));
+        spec.lot_size = Qty::parse(lot, char_traits<char>::length(lot));
+        return spec;
+    }
+
+    int64_t to_ticks(Price price) const {
+        return (price.raw + tick_size.raw / 2) / tick_size.raw;
+    }
+
+    Price from_ticks(int64_t ticks) const {
+        return Price(ticks * tick_size.raw);
+    }
+
+    Qty round_down_to_lot(Qty quantity) const {
+        return Qty(quantity.raw - quantity.raw % lot_size.raw);
+    }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef FUNDING_SLOT_HPP
+#define FUNDING_SLOT_HPP
+
+#include <cstdint>
+#include "fixed_point.hpp"
+#include "seqlock.hpp"
+
+using namespace std;
+
+// Latest funding terms of one perpetual, as the venue last reported them.
+struct FundingState {
+    Price mark_price;
+    Price index_price;
+    double funding_rate = 0.0;    // per funding interval
+    int64_t next_funding_ms = 0;  // venue time of the next settlement
+    int64_t event_time_ms = 0;
+    int64_t update_ns = 0;        // steady clock
+    bool has_rate = false;
+
+    bool has_mark() const { return mark_price.raw > 0; }
+};
+
+// Per-instrument funding and mark price, fed by the venue's funding channel
+// (Binance markPrice, Bybit tickers, OKX funding-rate and mark-price) and
+// read by pricing without locks. Updates merge: a field a message leaves
+// out keeps its last value. Single writer: the I/O thread of the
+// instrument's feed session.
+class FundingSlot {
+private:
+    SeqLock<FundingState> published;
+    FundingState current;
+
+public:
+    // Returns whether the funding rate changed.
+    bool offer(const FundingState& update, bool has_mark, bool has_index, int64_t now_ns) {
+        bool rate_changed = update.has_rate && (!current.has_rate || update.funding_rate != current.funding_rate);
+        if (has_mark) current.mark_price = update.mark_price;
+        if (has_index) current.index_price = update.index_price;
+        if (update.has_rate) {
+            current.funding_rate = update.funding_rate;
+            current.has_rate = true;
+        }
+        if (update.next_funding_ms != 0) current.next_funding_ms = update.next_funding_ms;
+        if (update.event_time_ms != 0) current.event_time_ms = update.event_time_ms;
+        current.update_ns = now_ns;
+        published.store(current);
+        return rate_changed;
+    }
+
+    FundingState load() const { return published.load(); }
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef INSTRUMENT_METADATA_HPP
+#define INSTRUMENT_METADATA_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "instrument_registry.hpp"
+
+using namespace std;
+
+// Fee rates apply from min_volume_usd of 30-day volume upwards.
+struct FeeTier {
+    double min_volume_usd = 0.0;
+    double maker_rate = 0.001;
+    double taker_rate = 0.001;
+};
+
+// Contract terms of one instrument: what pricing and risk used to assume.
+struct InstrumentMetadata {
+    InstrumentSpec spec;
+    double contract_multiplier = 1.0;
+    int64_t expiry_s = 0;               // unix seconds; 0 unless dated
+    double funding_interval_hours = 0;  // perpetuals only
+    vector<FeeTier> fee_tiers{FeeTier{}};
+
+    bool dated() const { return expiry_s != 0; }
+    bool perpetual() const { return !dated() && funding_interval_hours > 0; }
+
+    double years_to_expiry(int64_t now_s) const;
+    // Years over which a basis against this contract converges: to expiry
+    // when dated, one funding interval when perpetual, 0 for spot.
+    double horizon_years(int64_t now_s) const;
+    // Highest tier the volume qualifies for; tiers are sorted on load.
+    const FeeTier& fee_tier(double volume_usd = 0.0) const;
+};
+
+// Per-instrument metadata indexed by InstrumentId. Starts from the compiled
+// instrument table (perpetual futures, flat 0.1% fees) and is overlaid from
+// a JSON file at startup, before the feeds run:
+//
+//   {"instruments": [{"exchange": "OKX", "market": "Futures", "symbol": "BTC-USDT-SWAP",
+//                     "tick_size": "0.1", "lot_size": "0.01", "contract_multiplier": 0.01,
+//                     "expiry": null, "funding_interval_hours": 8,
+//                     "fee_tiers": [{"min_volume_usd": 0, "maker_bps": 2, "taker_bps": 5}]}]}
+//
+// "expiry" is "YYYY-MM-DD" (settling 08:00 UTC) or "YYYY-MM-DDTHH:MM:SSZ".
+class InstrumentMetadataStore {
+private:
+    vector<InstrumentMetadata> entries;
+
+public:
+    explicit InstrumentMetadataStore(const InstrumentRegistry& registry);
+
+    // Overlays the file's rows and pushes tick/lot sizes into the registry's
+    // books. Rows naming unknown instruments are skipped with a warning; a
+    // missing file leaves the defaults. Throws on malformed JSON. Returns
+    // the rows applied.
+    size_t load(const string& path, InstrumentRegistry& registry);
+
+    const InstrumentMetadata& get(InstrumentId id) const { return entries[id]; }
+    size_t size() const { return entries.size(); }
+};
+
+// "YYYY-MM-DD" (08:00 UTC) or "YYYY-MM-DDTHH:MM:SSZ" to unix seconds.
+int64_t parse_expiry(const string& text);
+
+int64_t unix_seconds();
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef INSTRUMENT_REGISTRY_HPP
+#define INSTRUMENT_REGISTRY_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "fast_orderbook.hpp"
+#include "bbo_slot.hpp"
+#include "funding_slot.hpp"
+
+using namespace std;
+
+enum class Exchange : uint8_t { Binance, Bybit, OKX };
+enum class Asset : uint8_t { Bitcoin, Ethereum };
+enum class MarketType : uint8_t { Spot, Futures };
+
+constexpr size_t EXCHANGE_COUNT = 3;
+constexpr size_t ASSET_COUNT = 2;
+constexpr size_t MARKET_TYPE_COUNT = 2;
+
+const char* exchange_name(Exchange exchange);
+const char* asset_name(Asset asset);
+const char* asset_code(Asset asset);
+const char* market_name(MarketType market);
+
+using InstrumentId = uint16_t;
+constexpr InstrumentId INVALID_INSTRUMENT = UINT16_MAX;
+
+// One row of the instrument table. Adding a symbol or venue is a new row here
+// (plus its enum entry); consumers only ever see the resulting IDs.
+struct InstrumentDefinition {
+    Exchange exchange;
+    Asset asset;
+    MarketType market;
+    const char* symbol;
+    const char* tick_size;
+    const char* lot_size;
+};
+
+const vector<InstrumentDefinition>& default_instrument_table();
+
+struct InstrumentInfo {
+    InstrumentId id;
+    Exchange exchange;
+    Asset asset;
+    MarketType market;
+    string symbol;
+    InstrumentSpec spec;
+
+    // "Bitcoin Spot", "Ethereum Futures"
+    string market_label() const;
+    // "Binance Bitcoin Spot"
+    string full_name() const;
+};
+
+// Assigns dense IDs to (exchange, asset, market) and owns one contiguous
+// array of books indexed by those IDs. IDs follow table order, so iterating
+// 0..size() walks the table as written.
+class InstrumentRegistry {
+private:
+    vector<InstrumentInfo> instruments;
+    FastOrderbook* books = nullptr;
+    unique_ptr<BboSlot[]> bbos;
+    unique_ptr<FundingSlot[]> fundings;
+    array<InstrumentId, EXCHANGE_COUNT * ASSET_COUNT * MARKET_TYPE_COUNT> index;
+
+    static size_t slot(Exchange exchange, Asset asset, MarketType market) {
+        return (static_cast<size_t>(exchange) * ASSET_COUNT + static_cast<size_t>(asset)) * MARKET_TYPE_COUNT +
+               static_cast<size_t>(market);
+    }
+
+public:
+    explicit InstrumentRegistry(const vector<InstrumentDefinition>& table = default_instrument_table());
+    ~InstrumentRegistry();
+
+    InstrumentRegistry(const InstrumentRegistry&) = delete;
+    InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+
+    size_t size() const { return instruments.size(); }
+
+    InstrumentId id(Exchange exchange, Asset asset, MarketType market) const {
+        return index[slot(exchange, asset, market)];
+    }
+
+    // Resolves the display names used by strategy code ("Bybit",
+    // "Ethereum_Futures"). Meant for edges like signal intake, not hot loops.
+    InstrumentId find(const string& exchange, const string& instrument) const;
+
+    const InstrumentInfo& info(InstrumentId id) const { return instruments[id]; }
+
+    // Replaces an instrument's tick and lot sizes and clears its book. Only
+    // before the feeds start.
+    void set_spec(InstrumentId id, const InstrumentSpec& spec);
+    const vector<InstrumentInfo>& all() const { return instruments; }
+
+    FastOrderbook& book(InstrumentId id) { return books[id]; }
+    const FastOrderbook& book(InstrumentId id) const { return books[id]; }
+
+    FastOrderbook& book(Exchange exchange, Asset asset, MarketType market) {
+        return books[id(exchange, asset, market)];
+    }
+
+    // Best bid/offer from whichever of the depth book and the top-of-book
+    // channel saw it first. What the pricing engines should read.
+    BboSlot& bbo(InstrumentId id) { return bbos[id]; }
+    const BboSlot& bbo(InstrumentId id) const { return bbos[id]; }
+
+    // Funding rate and mark price; only perpetuals are ever written.
+    FundingSlot& funding(InstrumentId id) { return fundings[id]; }
+    const FundingSlot& funding(InstrumentId id) const { return fundings[id]; }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef LEG_ARBITER_HPP
+#define LEG_ARBITER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// First-arrival-wins merge of one instrument's updates arriving on two
+// independent connections ("legs"). Updates are keyed by the venue's own
+// update ID (Binance/Bybit `u`, OKX seqId); the first copy of an ID is
+// applied and any later copy is dropped. Single writer: the reactor thread
+// that owns the session. Counters are atomics only so reporting can read them.
+class LegArbiter {
+public:
+    static constexpr int LEGS = 2;
+
+    enum class Verdict { Apply, Duplicate };
+
+private:
+    // Recent winning arrivals, so the losing copy can be timed against them.
+    static constexpr size_t HISTORY = 32;
+    struct Arrival {
+        int64_t id = 0;
+        int64_t ns = 0;
+        int leg = -1;
+    };
+
+    int64_t last_id = 0;
+    int last_leg = -1;
+    array<Arrival, HISTORY> history{};
+    size_t history_head = 0;
+
+public:
+    array<atomic<uint64_t>, LEGS> wins{};
+    // Sum and count of how far the winning leg was ahead of the other one.
+    array<atomic<uint64_t>, LEGS> lead_ns{};
+    array<atomic<uint64_t>, LEGS> lead_samples{};
+    atomic<uint64_t> duplicates{0};
+
+    // Forget the ordering, e.g. after the book was cleared for a resync.
+    void reset() {
+        last_id = 0;
+        last_leg = -1;
+        history.fill(Arrival{});
+    }
+
+    Verdict admit(int leg, int64_t id, bool is_snapshot, int64_t now_ns) {
+        if (id <= 0) return Verdict::Apply;  // unsequenced: nothing to merge on
+
+        if (id <= last_id) {
+            // A snapshot that goes backwards on the leg that set last_id can
+            // only be the venue restarting its sequence.
+            bool restart = is_snapshot && leg == last_leg;
+            if (!restart) {
+                duplicates.fetch_add(1, memory_order_relaxed);
+                record_loss(leg, id, now_ns);
+                return Verdict::Duplicate;
+            }
+            history.fill(Arrival{});
+        }
+
+        last_id = id;
+        last_leg = leg;
+        wins[leg].fetch_add(1, memory_order_relaxed);
+        history[history_head] = {id, now_ns, leg};
+        history_head = (history_head + 1) % HISTORY;
+        return Verdict::Apply;
+    }
+
+private:
+    void record_loss(int leg, int64_t id, int64_t now_ns) {
+        for (const auto& arrival : history) {
+            if (arrival.id != id || arrival.leg == leg) continue;
+            lead_ns[arrival.leg].fetch_add(static_cast<uint64_t>(now_ns - arrival.ns), memory_order_relaxed);
+            lead_samples[arrival.leg].fetch_add(1, memory_order_relaxed);
+            return;
+        }
+    }
+
+public:
+    static void benchmark_ab_merge();
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef MARKET_EVENT_BUS_HPP
+#define MARKET_EVENT_BUS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "book_storage.hpp"
+#include "seqlock.hpp"
+
+using namespace std;
+
+enum class MarketEventType : uint8_t {
+    BookUpdate,  // the depth book was published; bid/ask are its top
+    BboChange,   // the instrument's BboSlot changed quote; bid/ask are the new BBO
+    Funding      // the instrument's FundingSlot has a new rate; no quotes
+};
+
+// One normalized market data event. `sequence` is the bus's own, gap-free
+// across every instrument; `book_sequence` is the venue's. Empty quotes
+// mean the book or BBO was cleared.
+struct MarketEvent {
+    int64_t sequence = -1;
+    MarketEventType type = MarketEventType::BookUpdate;
+    BboSource source = BboSource::Depth;
+    InstrumentId instrument = INVALID_INSTRUMENT;
+    PriceLevel bid;
+    PriceLevel ask;
+    int64_t book_sequence = 0;
+    int64_t publish_ns = 0;  // steady clock
+
+    bool has_quotes() const { return bid.quantity.raw > 0 && ask.quantity.raw > 0; }
+    double mid() const { return has_quotes() ? (bid.price.to_double() + ask.price.to_double()) / 2.0 : 0.0; }
+};
+
+class MarketEventCursor;
+
+// Preallocated ring of market events in the style of a disruptor. Producers
+// (whichever threads publish books) claim a sequence with one fetch_add and
+// write the slot through its seqlock; they never wait for consumers. Every
+// consumer reads at its own MarketEventCursor without locks. A consumer that
+// falls a whole ring behind skips ahead and counts what it lost; current
+// state is always recoverable from the BboSlots.
+class MarketEventBus {
+public:
+    static constexpr size_t CAPACITY = 8192;
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static constexpr size_t SPIN_ROUNDS = 64;
+
+    unique_ptr<SeqLock<MarketEvent>[]> slots;
+    alignas(64) atomic<int64_t> claimed{0};
+
+    // Consumers blocked in MarketEventCursor::wait.
+    alignas(64) atomic<int> waiters{0};
+    mutex wait_mutex;
+    condition_variable wait_cv;
+
+    friend class MarketEventCursor;
+
+public:
+    MarketEventBus();
+
+    MarketEventBus(const MarketEventBus&) = delete;
+    MarketEventBus& operator=(const MarketEventBus&) = delete;
+
+    // Two producers only ever share a slot if one stalls for a whole ring.
+    void publish(MarketEventType type, InstrumentId instrument, BboSource source, const PriceLevel& bid,
+                 const PriceLevel& ask, int64_t book_sequence);
+
+    // Events published (claimed) so far.
+    int64_t published() const { return claimed.load(memory_order_acquire); }
+
+    static void benchmark_event_bus();
+};
+
+// One consumer's position on the bus. Not thread safe: each consumer owns
+// its cursor and reads from one thread at a time.
+class MarketEventCursor {
+private:
+    MarketEventBus* bus;
+    int64_t next;
+
+public:
+    // Events skipped after falling a whole ring behind.
+    uint64_t overruns = 0;
+
+    // Starts at the next event published.
+    explicit MarketEventCursor(MarketEventBus& event_bus) : bus(&event_bus), next(event_bus.published()) {}
+
+    bool poll(MarketEvent& event);
+    // Whether poll() would return an event (or find the cursor lapped).
+    bool ready() const;
+    // Blocks until ready() or the timeout passes; returns ready().
+    bool wait(chrono::microseconds timeout);
+
+    template<typename Handler>
+    size_t drain(Handler&& handler, size_t limit = numeric_limits<size_t>::max()) {
+        MarketEvent event;
+        size_t count = 0;
+        while (count < limit && poll(event)) {
+            handler(event);
+            ++count;
+        }
+        return count;
+    }
+
+    int64_t position() const { return next; }
+    int64_t lag() const { return bus->published() - next; }
+};
+
+// A consumer's private view of every instrument's latest BBO mid, built from
+// the BboChange events it has read, plus which instruments moved since it
+// last cleared them.
+class LatestMids {
+private:
+    vector<double> mids;
+    vector<uint8_t> dirty;
+    vector<InstrumentId> changed_ids;
+    vector<uint8_t> visited;
+
+public:
+    LatestMids();
+
+    void apply(const MarketEvent& event) {
+        if (event.type != MarketEventType::BboChange || event.instrument >= mids.size()) return;
+        mids[event.instrument] = event.mid();
+        if (!dirty[event.instrument]) {
+            dirty[event.instrument] = 1;
+            changed_ids.push_back(event.instrument);
+        }
+    }
+
+    // 0 until the instrument has a two-sided quote.
+    double mid(InstrumentId id) const { return mids[id]; }
+    const vector<InstrumentId>& changed() const { return changed_ids; }
+    void clear_changed();
+
+    // Calls handler(exchange, asset, spot_mid, futures_mid) once for every
+    // spot/futures pair with a changed leg and both legs quoted.
+    template<typename Handler>
+    void for_each_changed_basis(Handler&& handler);
+};
+
+extern MarketEventBus market_event_bus;
+
+template<typename Handler>
+void LatestMids::for_each_changed_basis(Handler&& handler) {
+    for (InstrumentId id : changed_ids) {
+        const InstrumentInfo& info = instrument_registry.info(id);
+        InstrumentId spot = instrument_registry.id(info.exchange, info.asset, MarketType::Spot);
+        InstrumentId futures = instrument_registry.id(info.exchange, info.asset, MarketType::Futures);
+        if (spot == INVALID_INSTRUMENT || futures == INVALID_INSTRUMENT || visited[spot]) continue;
+        visited[spot] = 1;
+        if (mids[spot] > 0 && mids[futures] > 0) handler(info.exchange, info.asset, mids[spot], mids[futures]);
+    }
+    for (InstrumentId id : changed_ids) {
+        const InstrumentInfo& info = instrument_registry.info(id);
+        InstrumentId spot = instrument_registry.id(info.exchange, info.asset, MarketType::Spot);
+        if (spot != INVALID_INSTRUMENT) visited[spot] = 0;
+    }
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <chrono>
+#include <mutex>
+#include "market_event_bus.hpp"
 
 struct ArbitrageLeg {
     std::string exchange;
@@ -35,12 +37,17 @@ struct RealMarketData {
     double                                   futures_price;
     double                                   basis_bps;
     double                                   implied_volatility;
+    double                                   time_to_expiry;  // years, from the futures leg's metadata
     std::chrono::steady_clock::time_point    timestamp;
 };
 
 class MultiLegArbitrageEngine {
 private:
     std::map<std::string, RealMarketData> market_data;
+    // Analysis and reporting run on different threads.
+    std::mutex multi_leg_mutex;
+    MarketEventCursor market_events{market_event_bus};
+    LatestMids mids;
 
     double calculate_implied_volatility_from_basis(double basis_bps,
                                                    double time_to_expiry);
@@ -53,14 +60,18 @@ private:
     std::vector<MultiLegStrategy> find_calendar_spreads();
     std::vector<MultiLegStrategy> find_synthetic_replication();
     std::vector<MultiLegStrategy> find_real_butterfly_spreads();
-    std::vector<MultiLegStrategy> scan_all_strategies();
 
 public:
     MultiLegArbitrageEngine();
     void update_market_data(const std::string& exchange,
                             const std::string& asset,
                             double            spot_price,
-                            double            futures_price);
+                            double            futures_price,
+                            double            time_to_expiry);
+    // Feeds every spot/futures pair whose BBO changed since the last call
+    // into update_market_data. Returns the events read.
+    size_t poll_market_events();
+    std::vector<MultiLegStrategy> scan_all_strategies();
 
     void print_multi_leg_opportunities();
 };
@@ -1,7 +0,0 @@
-#ifndef OKX_WS_HPP
-#define OKX_WS_HPP
-
-void start_okx_spot_ws();
-void start_okx_futures_ws();
-
-#endif
@@ -5,7 +5,10 @@
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <array>
 #include <atomic>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 
@@ -20,6 +23,70 @@ struct PerformanceMetrics {
     atomic<uint64_t> min_processing_time_ns{UINT64_MAX};
 };
 
+// Lock-free latency histogram with four log-linear buckets per power of two
+// (about 19% resolution), cheap enough to record from hot threads and read
+// from a reporting one.
+class LatencyHistogram {
+private:
+    static constexpr size_t BUCKETS = 160;
+    
+    array<atomic<uint64_t>, BUCKETS> buckets{};
+    atomic<uint64_t> samples{0};
+    atomic<uint64_t> total_ns{0};
+    atomic<uint64_t> max_ns{0};
+    
+    static size_t bucket(uint64_t ns) {
+        if (ns < 4) return static_cast<size_t>(ns);
+        int msb = 63 - __builtin_clzll(ns);
+        size_t index = static_cast<size_t>(msb - 1) * 4 + ((ns >> (msb - 2)) & 3);
+        return min(index, BUCKETS - 1);
+    }
+    
+    static uint64_t upper_edge(size_t index) {
+        if (index < 4) return index + 1;
+        int msb = static_cast<int>(index / 4) + 1;
+        return (5 + index % 4) << (msb - 2);
+    }
+    
+public:
+    void record(int64_t ns) {
+        uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        buckets[bucket(value)].fetch_add(1, memory_order_relaxed);
+        samples.fetch_add(1, memory_order_relaxed);
+        total_ns.fetch_add(value, memory_order_relaxed);
+        uint64_t seen = max_ns.load(memory_order_relaxed);
+        while (value > seen && !max_ns.compare_exchange_weak(seen, value, memory_order_relaxed)) {}
+    }
+    
+    uint64_t count() const { return samples.load(memory_order_relaxed); }
+    
+    // Upper edge of the bucket holding the p-th percentile.
+    double percentile_us(double p) const {
+        uint64_t n = count();
+        if (n == 0) return 0.0;
+        uint64_t rank = static_cast<uint64_t>(p * (n - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += buckets[i].load(memory_order_relaxed);
+            if (seen >= rank) return upper_edge(i) / 1e3;
+        }
+        return max_ns.load(memory_order_relaxed) / 1e3;
+    }
+    
+    void print(const string& label) const {
+        uint64_t n = count();
+        cout << left << setw(28) << label << right << setw(10) << n << fixed << setprecision(1)
+             << setw(12) << (n ? total_ns.load(memory_order_relaxed) / 1e3 / n : 0.0)
+             << setw(12) << percentile_us(0.50) << setw(12) << percentile_us(0.99)
+             << setw(12) << max_ns.load(memory_order_relaxed) / 1e3 << endl;
+    }
+    
+    static void print_header() {
+        cout << left << setw(28) << "Latency" << right << setw(10) << "Count" << setw(12) << "Avg (us)"
+             << setw(12) << "p50 (us)" << setw(12) << "p99 (us)" << setw(12) << "Max (us)" << endl;
+    }
+};
+
 class PerformanceMonitor;
 
 class PerformanceTimer {
@@ -6,6 +6,8 @@
 #include <string>
 #include <chrono>
 #include <mutex>
+#include "market_event_bus.hpp"
+#include "sampled_history.hpp"
 
 struct AssetPricePoint {
     double price;
@@ -43,10 +45,12 @@ private:
     std::map<std::string, std::vector<CrossAssetRatio>> ratio_history;
     std::map<std::string, double> current_prices;
     std::mutex cross_asset_mutex;
+    MarketEventCursor market_events{market_event_bus};
+    LatestMids mids;
     
     double min_ratio_spread_percent = 0.01;  
     double max_ratio_spread_percent = 2.0;   
-    int history_window = 20;
+    int history_window = 20;  // points, one per SAMPLE_INTERVAL
     
     std::string generate_price_key(const std::string& exchange, const std::string& asset);
     std::string generate_ratio_key(const std::string& exchange);
@@ -56,6 +60,9 @@ private:
 public:
     RealCrossAssetArbitrage();
     void update_asset_price(const std::string& exchange, const std::string& asset, double price);
+    // Feeds every spot instrument whose BBO changed since the last call into
+    // update_asset_price. Returns the events read.
+    size_t poll_market_events();
     std::vector<RealCrossAssetOpportunity> scan_real_cross_asset_opportunities();
     void print_real_cross_asset_analysis();
 };
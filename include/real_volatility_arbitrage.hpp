@@ -6,6 +6,8 @@
 #include <string>
 #include <chrono>
 #include <mutex>
+#include "market_event_bus.hpp"
+#include "sampled_history.hpp"
 
 struct MarketDataPoint {
     double spot_price;
@@ -42,10 +44,12 @@ private:
     std::map<std::string, std::vector<MarketDataPoint>> market_history;
     std::map<std::string, VolatilityIndicator> current_indicators;
     std::mutex volatility_mutex;
+    MarketEventCursor market_events{market_event_bus};
+    LatestMids mids;
     
     double min_vol_spread_bps = 20;   
     double max_vol_spread_bps = 500; 
-    int history_window = 30;         
+    int history_window = 30;         // points, one per SAMPLE_INTERVAL
     
     std::string generate_key(const std::string& exchange, const std::string& asset);
     double calculate_realized_volatility(const std::vector<MarketDataPoint>& history);
@@ -56,6 +60,9 @@ public:
     RealVolatilityArbitrage();
     void update_market_data(const std::string& exchange, const std::string& asset, 
                            double spot_price, double futures_price);
+    // Feeds every spot/futures pair whose BBO changed since the last call
+    // into update_market_data. Returns the events read.
+    size_t poll_market_events();
     std::vector<RealVolatilityOpportunity> scan_real_volatility_opportunities();
     void print_real_volatility_analysis();
 };
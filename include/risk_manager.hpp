@@ -7,6 +7,7 @@
 #include <mutex>
 #include <chrono>
 #include <atomic>
+#include "market_event_bus.hpp"
 
 using namespace std;
 
@@ -22,6 +23,9 @@ struct Position {
     chrono::steady_clock::time_point entry_time;
     bool is_active;
     string strategy_id; 
+    InstrumentId instrument_id = INVALID_INSTRUMENT;
+    // Underlying per unit of quantity; from the instrument metadata.
+    double contract_multiplier = 1.0;
 };
 
 struct TradeSignal {
@@ -82,6 +86,11 @@ private:
     mutable mutex risk_mutex;
     atomic<bool> emergency_stop{false};
     
+    // Book mids from BookUpdate events, marked onto positions in batches.
+    MarketEventCursor market_events{market_event_bus};
+    vector<double> book_mids;
+    vector<InstrumentId> marked;
+    
     // Internal calculations
     double calculate_position_size(const TradeSignal& signal);
     double calculate_risk_amount(double position_size, double entry_price, double stop_loss_price);
@@ -101,6 +110,9 @@ public:
     bool open_position(const TradeSignal& signal, double actual_fill_price);
     bool close_position(const string& position_id, double exit_price);
     void update_positions(const unordered_map<string, double>& current_prices);
+    // Marks open positions to the latest book mid of their instrument.
+    // Returns the events read.
+    size_t poll_market_events();
     
     RiskMetrics get_current_metrics();
     bool is_emergency_stop_triggered();
@@ -0,0 +1,29 @@
+#ifndef SAMPLED_HISTORY_HPP
+#define SAMPLED_HISTORY_HPP
+
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+// Julian year: what instrument expiries, funding horizons and the
+// analyzers' volatilities are all measured in.
+constexpr double SECONDS_PER_YEAR = 365.25 * 86400.0;
+
+// The analyzers react to every BBO event but keep one history point per
+// interval, so a fixed-length window spans a fixed stretch of time however
+// bursty the feed.
+constexpr chrono::milliseconds SAMPLE_INTERVAL{500};
+
+// Appends `point` (which has a steady_clock `timestamp`), or overwrites the
+// newest point while it is still inside its interval.
+template<typename Point>
+void add_sample(vector<Point>& history, const Point& point) {
+    if (history.size() >= 2 && point.timestamp - history[history.size() - 2].timestamp < SAMPLE_INTERVAL) {
+        history.back() = point;
+    } else {
+        history.push_back(point);
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+// Single-writer sequence lock. The writer bumps the sequence to an odd value,
+// stores the payload and bumps it back to even; readers retry until they see
+// the same even sequence on both sides of their copy. The payload is kept as
+// relaxed atomic words so concurrent copies are well defined.
+template<typename T>
+class SeqLock {
+    static_assert(is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) atomic<uint64_t> sequence{0};
+    array<atomic<uint64_t>, WORDS> words;
+
+public:
+    SeqLock() {
+        for (auto& word : words) word.store(0, memory_order_relaxed);
+    }
+
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        memcpy(buffer, &value, sizeof(T));
+
+        uint64_t seq = sequence.load(memory_order_relaxed);
+        sequence.store(seq + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i].store(buffer[i], memory_order_relaxed);
+        }
+        sequence.store(seq + 2, memory_order_release);
+    }
+
+    T load() const {
+        uint64_t buffer[WORDS];
+        uint64_t before, after;
+        do {
+            before = sequence.load(memory_order_acquire);
+            for (size_t i = 0; i < WORDS; ++i) {
+                buffer[i] = words[i].load(memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            after = sequence.load(memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+    uint64_t version() const {
+        return sequence.load(memory_order_acquire) >> 1;
+    }
+};
+
+#endif
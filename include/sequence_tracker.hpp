@@ -0,0 +1,142 @@
+#ifndef SEQUENCE_TRACKER_HPP
+#define SEQUENCE_TRACKER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "fast_json_parser.hpp"
+
+using namespace std;
+
+// Per-book continuity check for diff-depth streams. The venue's own IDs
+// decide whether an update follows the last one applied:
+//   Binance futures pu == last u, OKX prevSeqId == last seqId
+//   Binance spot    U == last u + 1
+//   Bybit           u == last u + 1
+// On a gap the book stops taking updates until a snapshot arrives. With a
+// REST snapshot (Binance) the diffs in between are buffered and replayed on
+// top of it; with an in-band snapshot (resubscribe on Bybit/OKX) they are
+// older than the snapshot and simply dropped.
+//
+// Single writer: the reactor thread that owns the book. Counters are atomics
+// only so reporting can read them.
+class SequenceTracker {
+public:
+    enum class Action {
+        Apply,   // in sequence: apply it
+        Drop,    // stale, or useless while waiting for a snapshot
+        Buffer,  // waiting for a REST snapshot: hold on to it
+        Resync   // gap: the update has been buffered if needed; fetch a snapshot
+    };
+
+    // Diffs held while a REST snapshot is in flight. Past this the buffer is
+    // dropped; the snapshot then fails to bridge and recovery starts over.
+    static constexpr size_t MAX_BUFFERED = 8192;
+
+private:
+    bool rest_snapshot;
+    bool live = false;
+    // The first update after a snapshot only has to reach it: spot needs
+    // U <= snapshot_id + 1 <= u, futures (whose IDs skip) U <= snapshot_id
+    // <= u or pu == snapshot_id.
+    bool bridging = false;
+    int64_t last_id = 0;
+    int64_t gap_started_ns = 0;
+    vector<string> buffered;
+
+    bool continues(const DepthMessage& m) const {
+        if (bridging) {
+            if (m.prev_update_id >= 0 && m.prev_update_id == last_id) return true;
+            return m.first_update_id <= last_id + 1 && m.last_update_id >= last_id;
+        }
+        if (m.prev_update_id >= 0) return m.prev_update_id == last_id;
+        if (m.first_update_id > 0) return m.first_update_id == last_id + 1;
+        return m.last_update_id == last_id + 1;
+    }
+
+    void hold(const string& payload) {
+        if (buffered.size() >= MAX_BUFFERED) buffered.clear();
+        buffered.push_back(payload);
+    }
+
+public:
+    atomic<uint64_t> gaps{0};
+    atomic<uint64_t> recoveries{0};
+    atomic<uint64_t> recovery_ns_total{0};
+    atomic<uint64_t> recovery_ns_max{0};
+
+    explicit SequenceTracker(bool uses_rest_snapshot) : rest_snapshot(uses_rest_snapshot) {}
+
+    bool is_live() const { return live; }
+    int64_t last_applied() const { return last_id; }
+    // When the current gap was detected; 0 if there is none.
+    int64_t gap_started() const { return gap_started_ns; }
+    bool needs_rest_snapshot() const { return rest_snapshot && !live; }
+
+    // Back to waiting for a snapshot, e.g. after a reconnect cleared the book.
+    // Not counted as a gap.
+    void reset() {
+        live = false;
+        bridging = false;
+        last_id = 0;
+        gap_started_ns = 0;
+        buffered.clear();
+    }
+
+    // The book was found to be wrong by other means (a checksum mismatch):
+    // wait for a snapshot as after a gap.
+    void invalidate(int64_t now_ns) {
+        live = false;
+        bridging = false;
+        if (gap_started_ns == 0) gap_started_ns = now_ns;
+        buffered.clear();
+    }
+
+    // Everything that is not an in-band snapshot goes through here.
+    Action on_update(const DepthMessage& m, const string& payload, int64_t now_ns) {
+        if (!live) {
+            if (!rest_snapshot) return Action::Drop;
+            hold(payload);
+            return Action::Buffer;
+        }
+        // While bridging, the event ending exactly at the snapshot still
+        // goes through: its levels are already in the book, and on futures
+        // it is often the only one that links up with it.
+        if (bridging ? m.last_update_id < last_id : m.last_update_id <= last_id) return Action::Drop;
+
+        if (continues(m)) {
+            bridging = false;
+            last_id = m.last_update_id;
+            return Action::Apply;
+        }
+
+        gaps.fetch_add(1, memory_order_relaxed);
+        live = false;
+        bridging = false;
+        if (gap_started_ns == 0) gap_started_ns = now_ns;
+        if (rest_snapshot) hold(payload);
+        return Action::Resync;
+    }
+
+    // The book has just been rebuilt from a snapshot as of `snapshot_id`.
+    // Returns the diffs to replay, in arrival order; the caller feeds them
+    // back through on_update.
+    vector<string> on_snapshot(int64_t snapshot_id, int64_t now_ns) {
+        live = true;
+        bridging = rest_snapshot;
+        last_id = snapshot_id;
+        if (gap_started_ns != 0) {
+            uint64_t took = static_cast<uint64_t>(now_ns - gap_started_ns);
+            recoveries.fetch_add(1, memory_order_relaxed);
+            recovery_ns_total.fetch_add(took, memory_order_relaxed);
+            if (took > recovery_ns_max.load(memory_order_relaxed)) recovery_ns_max.store(took, memory_order_relaxed);
+            gap_started_ns = 0;
+        }
+        vector<string> replay;
+        replay.swap(buffered);
+        return replay;
+    }
+};
+
+#endif
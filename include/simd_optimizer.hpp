@@ -60,6 +60,23 @@ public:
         vector<float>& synthetic_futures
     );
     
+    // Edges of every combination through one leg, over `count` lanes (a
+    // multiple of 8): buy_edges[j] = net_bids[j] * inv_cost - 1 buys the leg
+    // and sells lane j, sell_edges[i] = proceeds * inv_gross_asks[i] - 1
+    // buys lane i and sells the leg.
+    static void calculate_cross_edges_simd(
+        const float* net_bids,
+        const float* inv_gross_asks,
+        size_t count,
+        float inv_cost,
+        float proceeds,
+        float* buy_edges,
+        float* sell_edges
+    );
+    
+    // Lanes of `values` (a multiple of 8) strictly above threshold.
+    static size_t count_above_simd(const float* values, size_t count, float threshold);
+    
     static float calculate_mean_simd(const vector<float>& values);
     static float calculate_std_dev_simd(const vector<float>& values, float mean);
     static pair<float, float> find_min_max_simd(const vector<float>& values);
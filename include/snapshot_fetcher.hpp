@@ -0,0 +1,17 @@
+#ifndef SNAPSHOT_FETCHER_HPP
+#define SNAPSHOT_FETCHER_HPP
+
+#include <boost/asio/io_service.hpp>
+#include <functional>
+#include <string>
+
+using namespace std;
+
+// One-shot asynchronous HTTPS GET on an existing io_service, for REST depth
+// snapshots. Nothing blocks: resolve, connect, handshake, request and
+// response are all chained on the io_service, and `done` runs on its thread
+// with the body (ok == false on any error, non-200 status or timeout).
+void https_get(boost::asio::io_service& io, const string& host, const string& target,
+               function<void(bool ok, string body)> done);
+
+#endif
@@ -9,6 +9,11 @@
 #include <atomic>
 #include <cmath>
 #include <vector>  
+#include <memory>
+#include "instrument_registry.hpp"
+#include "market_event_bus.hpp"
+#include "performance_monitor.hpp"
+#include "seqlock.hpp"
 
 using namespace std;
 
@@ -17,6 +22,8 @@ struct SyntheticPrice {
     double synthetic_price;
     double mispricing_percent;
     double funding_rate;
+    double executable_size;    // in the underlying
+    double executable_profit;  // at fair value, after taker fees
     string exchange;
     string instrument_type; 
     chrono::steady_clock::time_point timestamp;
@@ -32,42 +39,142 @@ struct ConfigThresholds {
     bool enable_logging = true;
 };
 
+using SyntheticPairId = uint16_t;
+
+// How a pair's fair value is built from its reference leg.
+enum class PricingModel : uint8_t {
+    CostOfCarry,      // fair = reference * exp(rate * years_to_expiry)
+    PerpetualFunding  // fair = reference * (1 - funding_rate)
+};
+
+// One row of the synthetic pair table: the `priced` leg is compared with a
+// fair value built from the `reference` leg of the same exchange and asset.
+// A new pair or dated contract is a new row, not new code; a CostOfCarry
+// row's expiry is the priced leg's, from the instrument metadata.
+struct SyntheticPairDefinition {
+    Exchange exchange;
+    Asset asset;
+    MarketType priced;
+    MarketType reference;
+    PricingModel model;
+};
+
+const vector<SyntheticPairDefinition>& default_synthetic_pair_table();
+
+// A table row resolved against the instrument registry.
+struct SyntheticPair {
+    Exchange exchange;
+    Asset asset;
+    InstrumentId priced;
+    InstrumentId reference;
+    PricingModel model;
+    // Reporting labels, built once.
+    string exchange_label;
+    string instrument_type;
+};
+
+// Latest pricing of one pair, published through a seqlock so the pricing
+// thread never locks or allocates.
+struct SyntheticQuote {
+    double real_price = 0.0;
+    double synthetic_price = 0.0;
+    double mispricing_percent = 0.0;
+    double funding_rate = 0.0;
+    // What the books can take at a positive edge right now; only sized
+    // when the mispricing is past the threshold.
+    double executable_size = 0.0;
+    double executable_profit = 0.0;
+    int64_t update_ns = 0;  // steady clock; 0 until first priced
+    bool is_valid = false;
+};
+
 class SyntheticEngine {
 private:
-    unordered_map<string, SyntheticPrice> synthetic_prices;
-    mutable mutex synthetic_mutex;
     atomic<bool> running{true};
     ConfigThresholds config;
     thread calculation_thread;
     
-    unordered_map<string, double> funding_rates;
-    mutable mutex funding_mutex;
+    // Dated contracts' carry is recomputed this often as expiry approaches.
+    static constexpr int64_t CARRY_REFRESH_NS = 60LL * 1000000000;
+    
+    vector<SyntheticPair> pairs;
+    // What the pricing loop walks: each pair's legs with the rate in force
+    // and the factor it implies, so a reprice is one multiply. Factors are
+    // recomputed only when a rate or the time to expiry moves. Owned by
+    // calculation_thread once started.
+    struct PairPricing {
+        InstrumentId priced;
+        InstrumentId reference;
+        double rate;
+        double factor;
+    };
+    vector<PairPricing> pricing;
+    // Hand-set funding rate of each perpetual pair's contract, ahead of
+    // the feed's FundingSlot; NaN when not set.
+    unique_ptr<atomic<double>[]> pair_funding;
+    // Set when a rate or the config changes; the pricing thread refreshes.
+    atomic<bool> carry_stale{false};
+    bool has_dated_pairs = false;
+    int64_t next_carry_refresh_ns = 0;
+    
+    // Pairs each instrument is a leg of, by InstrumentId.
+    vector<vector<SyntheticPairId>> instrument_pairs;
+    unique_ptr<SeqLock<SyntheticQuote>[]> quotes;
+    
+    // Owned by calculation_thread once started.
+    MarketEventCursor market_events{market_event_bus};
+    LatestMids mids;
+    vector<uint8_t> pair_dirty;
+    vector<SyntheticPairId> dirty_pairs;
     
-    double calculate_synthetic_spot_from_perp(double perp_price, double funding_rate);
-    double calculate_synthetic_futures_price(double spot_price, double time_to_expiry, double rate);
     double calculate_mispricing_percent(double real_price, double synthetic_price);
     
-    double get_current_funding_rate(const string& exchange, const string& symbol);
-    double estimate_time_to_expiry(); 
+    // Recompute a pair's rate and factor (or every pair's), marking the
+    // pairs whose factor moved for repricing.
+    void refresh_factor(SyntheticPairId id, int64_t now_s);
+    void refresh_factors();
+    void mark_dirty(SyntheticPairId id);
     string generate_key(const string& exchange, const string& market);
     
+    // Reprices every pair with a leg in mids.changed(), once each, and
+    // clears them. Returns how many pairs were repriced.
+    size_t reprice_changed();
+    void reprice(SyntheticPairId id, int64_t now_ns);
+    SyntheticPrice to_price(SyntheticPairId id, const SyntheticQuote& quote) const;
+    
     void calculation_loop();
     
 public:
-    SyntheticEngine(const ConfigThresholds& cfg = ConfigThresholds{});
+    // Oldest quote change of a burst to its pairs repriced.
+    LatencyHistogram detection_latency;
+    // Pairs repriced, against what repricing every pair on every burst
+    // would have cost.
+    atomic<uint64_t> pairs_repriced{0};
+    atomic<uint64_t> bursts{0};
+    
+    // Rows whose legs are missing from the registry, or CostOfCarry rows
+    // whose priced leg has no expiry, are skipped.
+    SyntheticEngine(const ConfigThresholds& cfg = ConfigThresholds{},
+                    const vector<SyntheticPairDefinition>& table = default_synthetic_pair_table());
     ~SyntheticEngine();
     
     void start();
     void stop();
     
+    size_t pair_count() const { return pairs.size(); }
+    SyntheticQuote quote(SyntheticPairId id) const { return quotes[id].load(); }
+    
     vector<SyntheticPrice> get_mispricing_opportunities();
     SyntheticPrice get_synthetic_price(const string& exchange, const string& market);
     
+    // Pins a perpetual's funding rate over what its funding channel reports.
     void update_funding_rate(const string& exchange, const string& symbol, double rate);
     void set_config(const ConfigThresholds& cfg);
     
     void print_mispricing_opportunities();
     void log_synthetic_calculations();
+    
+    static void benchmark_incremental_repricing();
 };
 
 extern SyntheticEngine* global_synthetic_engine;
@@ -0,0 +1,154 @@
+#include "analysis_loop.hpp"
+#include "synthetic_engine.hpp"
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+int64_t steady_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+void lower_thread_priority() {
+#ifdef __linux__
+    // Linux nice values are per thread.
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+AnalysisLoop::AnalysisLoop(const Consumers& analyzers) : consumers(analyzers) {}
+
+AnalysisLoop::~AnalysisLoop() {
+    stop();
+}
+
+void AnalysisLoop::start() {
+    if (running.exchange(true)) return;
+    worker = thread([this]() { run(); });
+    cout << "[ANALYSIS LOOP] Analyzers now run on market events" << endl;
+}
+
+void AnalysisLoop::stop() {
+    if (!running.exchange(false)) return;
+    if (worker.joinable()) worker.join();
+}
+
+bool AnalysisLoop::analyze() {
+    consumers.volatility.poll_market_events();
+    consumers.cross_asset.poll_market_events();
+    if (consumers.multi_leg != nullptr) {
+        consumers.multi_leg->poll_market_events();
+    }
+    consumers.risk.poll_market_events();
+    if (consumers.basis != nullptr) {
+        consumers.basis->poll_market_events();
+    }
+
+    bool found = false;
+    for (const auto& opp : consumers.volatility.scan_real_volatility_opportunities()) found |= opp.is_executable;
+    for (const auto& opp : consumers.cross_asset.scan_real_cross_asset_opportunities()) found |= opp.is_executable;
+    if (consumers.multi_leg != nullptr) {
+        for (const auto& strategy : consumers.multi_leg->scan_all_strategies()) found |= strategy.is_executable;
+    }
+    if (consumers.basis != nullptr) found |= consumers.basis->opportunities() > 0;
+    return found;
+}
+
+void AnalysisLoop::run() {
+    while (running.load(memory_order_relaxed)) {
+        try {
+            if (!trigger.wait(chrono::milliseconds(IDLE_WAIT_MS))) continue;
+
+            // Everything already queued is one burst.
+            int64_t oldest_ns = numeric_limits<int64_t>::max();
+            size_t count = trigger.drain([&oldest_ns](const MarketEvent& event) {
+                oldest_ns = min(oldest_ns, event.publish_ns);
+            });
+            if (count == 0) continue;
+
+            bool found = analyze();
+            int64_t latency = steady_ns() - oldest_ns;
+            detection.record(latency);
+            if (found) opportunity.record(latency);
+            bursts.fetch_add(1, memory_order_relaxed);
+            events.fetch_add(count, memory_order_relaxed);
+        } catch (const exception& e) {
+            cout << "[ANALYSIS LOOP ERROR] " << e.what() << endl;
+        }
+    }
+}
+
+void AnalysisLoop::print_stats() const {
+    uint64_t burst_count = bursts.load(memory_order_relaxed);
+    uint64_t event_count = events.load(memory_order_relaxed);
+    cout << "\n[ANALYSIS LOOP] " << event_count << " events in " << burst_count << " bursts (" << fixed
+         << setprecision(1) << (burst_count ? event_count / double(burst_count) : 0.0) << " per recompute)" << endl;
+    LatencyHistogram::print_header();
+    detection.print("Book change -> analyzed");
+    opportunity.print("Book change -> opportunity");
+}
+
+// Replays quote changes for every spot/futures pair at a 30 bps basis, so
+// the volatility analyzer reports an executable opportunity after every
+// burst, and measures how long each burst takes to be detected. The old
+// loop fed the analyzers every tenth 50 ms cycle.
+void AnalysisLoop::benchmark_detection_latency() {
+    cout << "\n DETECTION LATENCY (event-driven analysis vs 500 ms polling)" << endl;
+    cout << string(60, '=') << endl;
+
+    RealVolatilityArbitrage volatility;
+    RealCrossAssetArbitrage cross_asset;
+    MultiLegArbitrageEngine multi_leg;
+    RiskManager risk;
+    ConfigThresholds thresholds;
+    thresholds.enable_logging = false;
+    thresholds.calculation_interval_ms = 100;
+    SyntheticEngine synthetic(thresholds);
+
+    AnalysisLoop loop({volatility, cross_asset, &multi_leg, risk});
+    loop.start();
+    synthetic.start();
+
+    const int bursts = 2000;
+    const int64_t burst_gap_ns = 1000000;
+    mt19937 gen(17);
+    normal_distribution<double> walk(0.0, 0.5);
+    vector<double> mids(instrument_registry.size());
+    for (const auto& info : instrument_registry.all()) {
+        double base = info.asset == Asset::Bitcoin ? 67000.0 : 3500.0;
+        mids[info.id] = info.market == MarketType::Futures ? base * 1.003 : base;
+    }
+
+    int64_t sequence = 0;
+    int64_t next_burst = steady_ns();
+    for (int b = 0; b < bursts; ++b) {
+        while (steady_ns() < next_burst) this_thread::yield();
+        next_burst += burst_gap_ns;
+        for (const auto& info : instrument_registry.all()) {
+            mids[info.id] += walk(gen) * (info.asset == Asset::Bitcoin ? 1.0 : 0.05);
+            PriceLevel bid{Price::from_double(mids[info.id] - 0.05), Qty::from_double(1.0)};
+            PriceLevel ask{Price::from_double(mids[info.id] + 0.05), Qty::from_double(1.0)};
+            market_event_bus.publish(MarketEventType::BboChange, info.id, BboSource::Depth, bid, ask, ++sequence);
+        }
+    }
+    this_thread::sleep_for(chrono::milliseconds(50));
+    loop.stop();
+    synthetic.stop();
+
+    cout << bursts << " bursts of " << instrument_registry.size() << " quote changes, one every "
+         << burst_gap_ns / 1000 << " us" << endl;
+    loop.print_stats();
+    synthetic.detection_latency.print("Book change -> repriced");
+    cout << "Polling every 500 ms: " << fixed << setprecision(1) << 250.0 << " ms average, up to 500 ms" << endl;
+    cout << string(60, '=') << endl;
+}
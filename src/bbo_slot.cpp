@@ -0,0 +1,160 @@
+#include "bbo_slot.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+const char* bbo_source_name(BboSource source) {
+    return source == BboSource::Depth ? "depth" : "ticker";
+}
+
+namespace {
+
+struct BookState {
+    int64_t sequence;
+    int64_t ns;
+    PriceLevel bid;
+    PriceLevel ask;
+};
+
+struct Delivery {
+    int64_t ns;
+    size_t state;
+    BboSource source;
+};
+
+// How long after each top-of-book change a slot first showed it (or a
+// later state).
+class ChangeLatency {
+    const vector<size_t>& changes;
+    const vector<BookState>& states;
+    size_t next = 0;
+
+public:
+    vector<int64_t> samples;
+
+    ChangeLatency(const vector<size_t>& change_states, const vector<BookState>& book_states)
+        : changes(change_states), states(book_states) {}
+
+    void seen(int64_t sequence, int64_t now_ns) {
+        while (next < changes.size() && states[changes[next]].sequence <= sequence) {
+            samples.push_back(now_ns - states[changes[next]].ns);
+            ++next;
+        }
+    }
+};
+
+double percentile_ms(vector<int64_t> values, double p) {
+    if (values.empty()) return 0.0;
+    sort(values.begin(), values.end());
+    return values[min(values.size() - 1, static_cast<size_t>(values.size() * p))] / 1e6;
+}
+
+}
+
+// One instrument's book moves every 100 us and its touch changes on about a
+// third of those moves. The depth channel pushes the book every 20 ms (as
+// Bybit's orderbook.50 does); the top-of-book channel pushes every touch
+// change as it happens. Both take the same path, so the slot should publish
+// every state in sequence order, mostly from the ticker, with the depth book
+// winning only the changes the ticker was still carrying when a push landed.
+void BboSlot::benchmark_bbo_sources() {
+    cout << "\n BBO SLOT (depth book vs top-of-book channel)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t count = 200000;
+    const int64_t interval_ns = 100000;
+    const size_t depth_every = 200;
+    mt19937_64 gen(23);
+    bernoulli_distribution touch_moves(0.33);
+    uniform_int_distribution<int> step(-2, 2);
+    uniform_int_distribution<int64_t> size(1, 500000000);
+    lognormal_distribution<double> latency(log(600000.0), 0.35);
+
+    vector<BookState> states;
+    vector<size_t> changes;
+    states.reserve(count);
+    int64_t bid = 6712300000000;
+    const int64_t tick = 10000000;
+    PriceLevel top_bid{Price(bid), Qty(size(gen))};
+    PriceLevel top_ask{Price(bid + tick), Qty(size(gen))};
+    for (size_t i = 0; i < count; ++i) {
+        if (touch_moves(gen)) {
+            bid += step(gen) * tick;
+            top_bid = {Price(bid), Qty(size(gen))};
+            top_ask = {Price(bid + tick), Qty(size(gen))};
+            changes.push_back(i);
+        }
+        states.push_back({static_cast<int64_t>(i) + 1, static_cast<int64_t>(i) * interval_ns, top_bid, top_ask});
+    }
+
+    // Each channel is one TCP stream, so it delivers in order.
+    vector<Delivery> deliveries;
+    int64_t depth_previous = 0;
+    int64_t ticker_previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool touch_changed = binary_search(changes.begin(), changes.end(), i);
+        if (touch_changed) {
+            ticker_previous = max(ticker_previous, states[i].ns + static_cast<int64_t>(latency(gen)));
+            deliveries.push_back({ticker_previous, i, BboSource::Ticker});
+        }
+        if ((i + 1) % depth_every == 0) {
+            depth_previous = max(depth_previous, states[i].ns + static_cast<int64_t>(latency(gen)));
+            deliveries.push_back({depth_previous, i, BboSource::Depth});
+        }
+    }
+    stable_sort(deliveries.begin(), deliveries.end(), [](const Delivery& a, const Delivery& b) { return a.ns < b.ns; });
+
+    BboSlot merged;
+    BboSlot depth_only;
+    ChangeLatency merged_latency(changes, states);
+    ChangeLatency depth_latency(changes, states);
+    size_t backwards = 0;
+    size_t wrong_quote = 0;
+    int64_t last_sequence = 0;
+
+    auto start = chrono::high_resolution_clock::now();
+    for (const auto& delivery : deliveries) {
+        const BookState& state = states[delivery.state];
+        merged.offer(delivery.source, state.bid, state.ask, state.sequence, delivery.ns);
+        if (delivery.source == BboSource::Depth) {
+            depth_only.offer(delivery.source, state.bid, state.ask, state.sequence, delivery.ns);
+            depth_latency.seen(state.sequence, delivery.ns);
+        }
+
+        Bbo published = merged.load();
+        backwards += published.sequence < last_sequence;
+        last_sequence = published.sequence;
+        const BookState& truth = states[published.sequence - 1];
+        wrong_quote += !(published.bid.price == truth.bid.price && published.bid.quantity == truth.bid.quantity &&
+                         published.ask.price == truth.ask.price && published.ask.quantity == truth.ask.quantity);
+        merged_latency.seen(published.sequence, delivery.ns);
+    }
+    double offer_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::high_resolution_clock::now() - start).count() / double(deliveries.size());
+
+    cout << "Touch changes:        " << changes.size() << " over " << count << " book updates, "
+         << deliveries.size() << " deliveries" << endl;
+    cout << left << setw(22) << "Depth book only" << right << "p50 " << fixed << setprecision(2) << setw(7)
+         << percentile_ms(depth_latency.samples, 0.50) << " ms  p99 " << setw(7)
+         << percentile_ms(depth_latency.samples, 0.99) << " ms" << endl;
+    cout << left << setw(22) << "Depth + ticker slot" << right << "p50 " << setw(7)
+         << percentile_ms(merged_latency.samples, 0.50) << " ms  p99 " << setw(7)
+         << percentile_ms(merged_latency.samples, 0.99) << " ms" << endl;
+
+    uint64_t total = merged.wins[0] + merged.wins[1];
+    for (size_t source = 0; source < BBO_SOURCE_COUNT; ++source) {
+        double lead = merged.lead_samples[source] ? merged.lead_ns[source] / 1e6 / merged.lead_samples[source] : 0.0;
+        cout << "First from " << left << setw(7) << bbo_source_name(static_cast<BboSource>(source)) << right
+             << setprecision(1) << setw(6) << (total ? 100.0 * merged.wins[source] / total : 0.0)
+             << "% (leads by " << setprecision(2) << lead << " ms)" << endl;
+    }
+    cout << "Published " << backwards << " out of order, " << wrong_quote << " quotes not matching their sequence, "
+         << "offer+load " << setprecision(1) << offer_ns << " ns/delivery" << endl;
+    cout << string(60, '=') << endl;
+}
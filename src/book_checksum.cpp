@@ -0,0 +1,156 @@
+#include "book_checksum.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+
+// Price and size exactly as OKX would print them.
+string wire_decimal(double value, int decimals) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    string text(buffer);
+    if (text.find('.') != string::npos) {
+        text.erase(text.find_last_not_of('0') + 1);
+        if (text.back() == '.') text.pop_back();
+    }
+    return text;
+}
+
+struct WireLevel {
+    bool is_bid;
+    string price;
+    string size;  // "0" deletes
+};
+
+// The spec's way: keep the wire strings, build the checksum string, CRC it.
+class WireBook {
+    map<double, pair<string, string>, greater<double>> bids;
+    map<double, pair<string, string>> asks;
+
+public:
+    void apply(const WireLevel& level) {
+        double key = stod(level.price);
+        if (level.is_bid) {
+            if (level.size == "0") bids.erase(key); else bids[key] = {level.price, level.size};
+        } else {
+            if (level.size == "0") asks.erase(key); else asks[key] = {level.price, level.size};
+        }
+    }
+
+    int32_t checksum() const {
+        vector<const pair<string, string>*> b, a;
+        for (auto it = bids.begin(); it != bids.end() && b.size() < OKX_CHECKSUM_LEVELS; ++it) b.push_back(&it->second);
+        for (auto it = asks.begin(); it != asks.end() && a.size() < OKX_CHECKSUM_LEVELS; ++it) a.push_back(&it->second);
+        string text;
+        for (size_t i = 0; i < max(b.size(), a.size()); ++i) {
+            if (i < b.size()) text += b[i]->first + ":" + b[i]->second + ":";
+            if (i < a.size()) text += a[i]->first + ":" + a[i]->second + ":";
+        }
+        if (!text.empty()) text.pop_back();
+        return static_cast<int32_t>(~crc32_detail::table_update(0xFFFFFFFFu, reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+    }
+};
+
+// A 400-level BTC-USDT book (tick 0.1) followed by incremental updates of a
+// few levels each, mostly near the touch, about a third of them deletions.
+vector<vector<WireLevel>> generate_okx_updates(size_t count) {
+    mt19937 gen(7);
+    normal_distribution<double> walk(0.0, 0.2);
+    exponential_distribution<double> distance(0.05);
+    uniform_real_distribution<double> size(0.00001, 3.0);
+    uniform_int_distribution<int> levels(1, 8);
+    bernoulli_distribution deletion(0.3);
+
+    double mid = 67123.4;
+    vector<vector<WireLevel>> updates;
+    vector<WireLevel> snapshot;
+    for (int i = 1; i <= 400; ++i) {
+        snapshot.push_back({true, wire_decimal(mid - i * 0.1, 1), wire_decimal(size(gen), 8)});
+        snapshot.push_back({false, wire_decimal(mid + i * 0.1, 1), wire_decimal(size(gen), 8)});
+    }
+    updates.push_back(snapshot);
+
+    for (size_t u = 1; u < count; ++u) {
+        mid += walk(gen);
+        vector<WireLevel> update;
+        for (int i = levels(gen); i > 0; --i) {
+            bool is_bid = i % 2 == 0;
+            double offset = 0.1 * (1 + static_cast<int>(distance(gen)));
+            double price = round((is_bid ? mid - offset : mid + offset) * 10.0) / 10.0;
+            update.push_back({is_bid, wire_decimal(price, 1), deletion(gen) ? "0" : wire_decimal(size(gen), 8)});
+        }
+        updates.push_back(update);
+    }
+    return updates;
+}
+
+}
+
+// Replays an OKX-style book and checks the incremental checksum against the
+// spec's string-building version on every update, then times both.
+void benchmark_book_checksum() {
+    cout << "\n OKX BOOK CHECKSUM (CRC-32 over top 25 levels)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t count = 20000;
+    auto updates = generate_okx_updates(count);
+
+    FastOrderbook book(InstrumentSpec::make("0.1", "0.00000001"));
+    WireBook wire;
+    OkxBookChecksum cached;
+    size_t mismatches = 0;
+    int64_t cached_ns = 0;
+    int64_t render_ns = 0;
+    int64_t string_ns = 0;
+
+    for (const auto& update : updates) {
+        for (const auto& level : update) {
+            Price price = Price::parse(level.price);
+            Qty size = Qty::parse(level.size);
+            if (level.is_bid) book.apply_bid(price, size); else book.apply_ask(price, size);
+            wire.apply(level);
+        }
+
+        auto t0 = chrono::high_resolution_clock::now();
+        int32_t incremental = cached(book);
+        auto t1 = chrono::high_resolution_clock::now();
+        int32_t rendered = okx_book_checksum(book);
+        auto t2 = chrono::high_resolution_clock::now();
+        int32_t reference = wire.checksum();
+        auto t3 = chrono::high_resolution_clock::now();
+
+        cached_ns += chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+        render_ns += chrono::duration_cast<chrono::nanoseconds>(t2 - t1).count();
+        string_ns += chrono::duration_cast<chrono::nanoseconds>(t3 - t2).count();
+        mismatches += incremental != reference || rendered != reference;
+    }
+
+    // Steady-state cost without the per-call clock reads.
+    const int rounds = 200000;
+    int64_t sink = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) sink += cached(book);
+    double loop_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::high_resolution_clock::now() - start).count() / double(rounds);
+
+#ifdef __PCLMUL__
+    const char* engine = "PCLMUL fold";
+#else
+    const char* engine = "table";
+#endif
+    cout << "Updates verified:     " << count << " (" << mismatches << " mismatches vs string CRC)" << endl;
+    cout << "CRC engine:           " << engine << endl;
+    cout << "Cached level text:    " << fixed << setprecision(1) << cached_ns / double(count) << " ns/update, "
+         << loop_ns << " ns unchanged book (sink " << sink % 997 << ")" << endl;
+    cout << "Render every level:   " << render_ns / double(count) << " ns/update" << endl;
+    cout << "String + table CRC:   " << string_ns / double(count) << " ns/update" << endl;
+    cout << string(60, '=') << endl;
+}
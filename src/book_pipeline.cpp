@@ -0,0 +1,340 @@
+#include "book_pipeline.hpp"
+#include "feed_decoder.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+
+int64_t steady_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+BookLane::BookLane(FastOrderbook& target, BboSlot& slot, unique_ptr<OkxBookChecksum> book_checksum,
+                   BookPipeline* book_pipeline, MarketEventBus* event_bus, InstrumentId instrument_id)
+    : book(&target), bbo(&slot), checksum(move(book_checksum)), pipeline(book_pipeline), events(event_bus),
+      instrument(instrument_id) {}
+
+void BookLane::push(const LevelUpdate& update) {
+    if (pipeline == nullptr) {
+        consume(&update, 1);
+        return;
+    }
+    if (!ring.try_push(update)) {
+        stalls.fetch_add(1, memory_order_relaxed);
+        do {
+            pipeline->wake();
+            this_thread::yield();
+        } while (!ring.try_push(update));
+    }
+    // Levels wait for their Commit; anything that ends a message goes now.
+    if (update.kind != LevelUpdate::Kind::Bid && update.kind != LevelUpdate::Kind::Ask &&
+        update.kind != LevelUpdate::Kind::TickerBid) {
+        pipeline->wake();
+    }
+}
+
+void BookLane::book_event(int64_t sequence) {
+    if (events) events->publish(MarketEventType::BookUpdate, instrument, BboSource::Depth, book->get_best_bid(),
+                                book->get_best_ask(), sequence);
+}
+
+void BookLane::bbo_event(BboSource source, const PriceLevel& bid, const PriceLevel& ask, int64_t sequence) {
+    if (events) events->publish(MarketEventType::BboChange, instrument, source, bid, ask, sequence);
+}
+
+void BookLane::finish(const LevelUpdate& commit, int64_t now_ns) {
+    if (checksum && commit.has_checksum && (*checksum)(*book) != commit.checksum) {
+        // Readers price off the BBO, not the book: retract the depth quote
+        // too, or they would keep trading on the diverged book.
+        diverged = true;
+        book->clear();
+        book->publish();
+        bbo->reset();
+        book_event(commit.sequence);
+        bbo_event(BboSource::Depth, PriceLevel{}, PriceLevel{}, commit.sequence);
+        if (on_checksum_mismatch) on_checksum_mismatch(commit.sequence);
+        return;
+    }
+    book->publish();
+    book_event(commit.sequence);
+    if (book->has_quotes()) {
+        PriceLevel bid = book->get_best_bid();
+        PriceLevel ask = book->get_best_ask();
+        if (bbo->offer(BboSource::Depth, bid, ask, commit.sequence, now_ns)) {
+            bbo_event(BboSource::Depth, bid, ask, commit.sequence);
+        }
+    }
+}
+
+void BookLane::consume(const LevelUpdate* updates, size_t count) {
+    // Every state before the last Commit is already superseded, so only
+    // that one is published (and checksummed).
+    size_t last_commit = count;
+    for (size_t i = count; i-- > 0;) {
+        if (updates[i].kind == LevelUpdate::Kind::Commit) {
+            last_commit = i;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const LevelUpdate& update = updates[i];
+        switch (update.kind) {
+            case LevelUpdate::Kind::Bid:
+                if (!diverged) book->apply_bid(update.level.price, update.level.quantity);
+                break;
+            case LevelUpdate::Kind::Ask:
+                if (!diverged) book->apply_ask(update.level.price, update.level.quantity);
+                break;
+            case LevelUpdate::Kind::Clear:
+                diverged = false;
+                book->clear();
+                break;
+            case LevelUpdate::Kind::Reset:
+                diverged = false;
+                book->clear();
+                book->publish();
+                bbo->reset();
+                ticker_bid = PriceLevel{};
+                book_event(0);
+                bbo_event(BboSource::Depth, PriceLevel{}, PriceLevel{}, 0);
+                break;
+            case LevelUpdate::Kind::Commit:
+                if (i == last_commit && !diverged) finish(update, steady_ns());
+                break;
+            case LevelUpdate::Kind::TickerBid:
+                ticker_bid = update.level;
+                break;
+            case LevelUpdate::Kind::TickerAsk:
+                if (bbo->offer(BboSource::Ticker, ticker_bid, update.level, update.sequence, steady_ns())) {
+                    bbo_event(BboSource::Ticker, ticker_bid, update.level, update.sequence);
+                }
+                break;
+        }
+    }
+}
+
+size_t BookLane::drain() {
+    LevelUpdate batch[DRAIN_BATCH];
+    size_t count = ring.pop_batch(batch, DRAIN_BATCH);
+    if (count) consume(batch, count);
+    return count;
+}
+
+BookPipeline::~BookPipeline() {
+    stop();
+}
+
+void BookPipeline::start() {
+    if (running.exchange(true)) return;
+    worker = thread([this]() { run(); });
+}
+
+void BookPipeline::stop() {
+    if (!running.exchange(false)) return;
+    {
+        lock_guard<mutex> lock(park_mutex);
+        park_cv.notify_one();
+    }
+    if (worker.joinable()) worker.join();
+}
+
+void BookPipeline::run() {
+    size_t idle_rounds = 0;
+    while (running.load(memory_order_relaxed)) {
+        size_t applied = 0;
+        for (BookLane* lane : lanes) {
+            size_t n = lane->drain();
+            if (n) {
+                applied += n;
+                batches.fetch_add(1, memory_order_relaxed);
+            }
+        }
+        if (applied) {
+            records.fetch_add(applied, memory_order_relaxed);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < SPIN_ROUNDS) {
+            this_thread::yield();
+            continue;
+        }
+
+        unique_lock<mutex> lock(park_mutex);
+        parked.store(true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool pending = false;
+        for (BookLane* lane : lanes) pending |= !lane->idle();
+        // The timeout only bounds a missed wake-up; producers notify.
+        if (!pending && running.load(memory_order_relaxed)) park_cv.wait_for(lock, chrono::milliseconds(1));
+        parked.store(false, memory_order_relaxed);
+        idle_rounds = 0;
+    }
+}
+
+uint64_t BookPipeline::stalls() const {
+    uint64_t total = 0;
+    for (const BookLane* lane : lanes) total += lane->stalls.load(memory_order_relaxed);
+    return total;
+}
+
+void BookPipeline::print_stats() const {
+    uint64_t applied = records.load(memory_order_relaxed);
+    uint64_t runs = batches.load(memory_order_relaxed);
+    cout << "[BOOK PIPELINE] " << lanes.size() << " books, " << applied << " records in " << runs << " batches ("
+         << fixed << setprecision(1) << (runs ? applied / double(runs) : 0.0) << " per batch), "
+         << stalls() << " producer stalls" << endl;
+}
+
+namespace {
+
+using PipelineDecoder = Decoder<Exchange::Binance, Channel::Depth>;
+
+vector<string> pipeline_payloads(size_t count) {
+    mt19937 gen(31);
+    normal_distribution<double> walk(0.0, 0.3);
+    exponential_distribution<double> distance(0.3);
+    uniform_real_distribution<double> size(0.001, 2.0);
+    uniform_int_distribution<int> levels(3, 20);
+    bernoulli_distribution deletion(0.3);
+
+    vector<string> payloads;
+    double mid = 67123.4;
+    for (size_t n = 0; n < count; ++n) {
+        mid += walk(gen);
+        string sides[2];
+        for (int s = 0; s < 2; ++s) {
+            sides[s] = "[";
+            for (int i = levels(gen); i > 0; --i) {
+                double offset = 0.1 + round(distance(gen) * 10.0) / 10.0;
+                double price = round((s == 0 ? mid - offset : mid + offset) * 10.0) / 10.0;
+                char level[64];
+                snprintf(level, sizeof(level), "%s[\"%.1f\",\"%.5f\"]", sides[s].size() > 1 ? "," : "", price,
+                         deletion(gen) ? 0.0 : size(gen));
+                sides[s] += level;
+            }
+            sides[s] += "]";
+        }
+        payloads.push_back("{\"stream\":\"btcusdt@depth\",\"data\":{\"e\":\"depthUpdate\",\"E\":1700000000000,"
+                           "\"s\":\"BTCUSDT\",\"U\":" + to_string(n + 1) + ",\"u\":" + to_string(n + 1) +
+                           ",\"b\":" + sides[0] + ",\"a\":" + sides[1] + "}}");
+    }
+    return payloads;
+}
+
+struct PipelineRun {
+    double producer_ns = 0;
+    double drained_ms = 0;
+    vector<BookSnapshot> books;
+    uint64_t records = 0;
+    uint64_t batches = 0;
+    uint64_t stalls = 0;
+};
+
+// Decodes every payload on this thread, as a reactor would, and hands each
+// message to `books` lanes either inline or through a BookPipeline.
+PipelineRun run_pipeline(const vector<string>& payloads, size_t book_count, size_t burst, bool piped) {
+    const InstrumentSpec spec = InstrumentSpec::make("0.1", "0.00001");
+    vector<unique_ptr<FastOrderbook>> books;
+    vector<unique_ptr<BboSlot>> slots;
+    vector<unique_ptr<BookLane>> lanes;
+    BookPipeline pipeline;
+    for (size_t b = 0; b < book_count; ++b) {
+        books.push_back(make_unique<FastOrderbook>(spec));
+        slots.push_back(make_unique<BboSlot>());
+        lanes.push_back(make_unique<BookLane>(*books.back(), *slots.back(), nullptr, piped ? &pipeline : nullptr));
+        pipeline.add(*lanes.back());
+    }
+    if (piped) pipeline.start();
+
+    int64_t producer_total = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t n = 0; n < payloads.size(); ++n) {
+        BookLane& lane = *lanes[(n / burst) % book_count];
+        const string& payload = payloads[n];
+        int64_t t0 = steady_ns();
+        DepthMessage depth;
+        if (PipelineDecoder::decode(payload.data(), payload.size(), depth)) {
+            PipelineDecoder::apply(depth, lane);
+            lane.commit(depth.book_sequence());
+        }
+        producer_total += steady_ns() - t0;
+        // Gaps between bursts, as a network read loop would see them.
+        if ((n + 1) % burst == 0) this_thread::yield();
+    }
+    if (piped) {
+        bool drained = false;
+        while (!drained) {
+            drained = true;
+            for (auto& lane : lanes) drained &= lane->idle();
+            if (!drained) this_thread::yield();
+        }
+        // Everything is popped; stop() joins once the last batch is applied.
+        pipeline.stop();
+    }
+
+    PipelineRun run;
+    run.drained_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    run.producer_ns = producer_total / double(payloads.size());
+    for (auto& book : books) run.books.push_back(book->snapshot());
+    run.records = pipeline.records;
+    run.batches = pipeline.batches;
+    run.stalls = pipeline.stalls();
+    return run;
+}
+
+bool same_books(const vector<BookSnapshot>& a, const vector<BookSnapshot>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].bid_depth != b[i].bid_depth || a[i].ask_depth != b[i].ask_depth ||
+            a[i].bid_count != b[i].bid_count || a[i].ask_count != b[i].ask_count) {
+            return false;
+        }
+        for (size_t l = 0; l < a[i].bid_depth; ++l) {
+            if (!(a[i].bids[l].price == b[i].bids[l].price) || !(a[i].bids[l].quantity == b[i].bids[l].quantity)) return false;
+        }
+        for (size_t l = 0; l < a[i].ask_depth; ++l) {
+            if (!(a[i].asks[l].price == b[i].asks[l].price) || !(a[i].asks[l].quantity == b[i].asks[l].quantity)) return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// The reactor's side of the trade: what each message costs the thread that
+// reads the socket when it applies and publishes the book itself, against
+// handing normalized levels to the book thread. Both runs must leave the
+// books identical.
+void BookPipeline::benchmark_pipeline() {
+    cout << "\n BOOK PIPELINE (reactor apply vs SPSC rings to a book thread)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t count = 100000;
+    const size_t books = 4;
+    const size_t burst = 16;
+    auto payloads = pipeline_payloads(count);
+
+    PipelineRun inline_run = run_pipeline(payloads, books, burst, false);
+    PipelineRun piped_run = run_pipeline(payloads, books, burst, true);
+
+    cout << count << " depth messages over " << books << " books, bursts of " << burst << endl;
+    cout << left << setw(22) << "Apply on reactor" << right << fixed << setprecision(1) << setw(8)
+         << inline_run.producer_ns << " ns/msg on the reactor, done in " << setprecision(1)
+         << inline_run.drained_ms << " ms" << endl;
+    cout << left << setw(22) << "Book thread pipeline" << right << setw(8) << piped_run.producer_ns
+         << " ns/msg on the reactor, drained in " << piped_run.drained_ms << " ms" << endl;
+    cout << "Book thread: " << piped_run.records << " records in " << piped_run.batches << " batches ("
+         << (piped_run.batches ? piped_run.records / double(piped_run.batches) : 0.0) << " per batch), "
+         << piped_run.stalls << " producer stalls" << endl;
+    cout << "Final books " << (same_books(inline_run.books, piped_run.books) ? "identical" : "DIFFER") << endl;
+    cout << string(60, '=') << endl;
+}
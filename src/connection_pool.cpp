@@ -0,0 +1,83 @@
+#include "connection_pool.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+ConnectionPool::ConnectionPool(size_t io_threads) {
+    io_threads = max<size_t>(io_threads, 1);
+    for (size_t i = 0; i < io_threads; ++i) {
+        // Each io_service is only ever run by its own thread.
+        loops.push_back(make_unique<boost::asio::io_service>(1));
+    }
+    cout << "[CONNECTION POOL]  Initialized with " << io_threads << " I/O thread(s)" << endl;
+}
+
+ConnectionPool::~ConnectionPool() {
+    stop_all_connections();
+}
+
+ConnectionStats& ConnectionPool::track(const string& name) {
+    lock_guard<mutex> lock(stats_mutex);
+    stats.push_back(make_unique<ConnectionStats>(name));
+    window_start.push_back(Sample{});
+    return *stats.back();
+}
+
+void ConnectionPool::start_all_connections() {
+    if (pool_running.exchange(true)) return;
+    for (size_t i = 0; i < loops.size(); ++i) {
+        keep_alive.push_back(make_unique<boost::asio::io_service::work>(*loops[i]));
+        threads.emplace_back([this, i]() {
+            try {
+                loops[i]->run();
+            } catch (const exception& e) {
+                cout << "[ERROR] Connection pool I/O thread " << i << " error: " << e.what() << endl;
+            }
+        });
+    }
+    lock_guard<mutex> lock(stats_mutex);
+    cout << "[CONNECTION POOL] Running " << stats.size() << " connection(s) on " << loops.size()
+         << " I/O thread(s)" << endl;
+}
+
+void ConnectionPool::stop_all_connections() {
+    if (!pool_running.exchange(false)) return;
+    keep_alive.clear();
+    for (auto& loop : loops) loop->stop();
+    for (auto& t : threads) {
+        if (t.joinable()) t.join();
+    }
+    threads.clear();
+    cout << "[CONNECTION POOL]  Stopped all connections" << endl;
+}
+
+void ConnectionPool::print_connection_stats() {
+    lock_guard<mutex> lock(stats_mutex);
+    auto now = chrono::steady_clock::now();
+    double seconds = max(chrono::duration<double>(now - window_started).count(), 1e-9);
+
+    cout << "\n CONNECTION POOL STATISTICS (last " << fixed << setprecision(1) << seconds << " s)" << endl;
+    cout << string(92, '=') << endl;
+    cout << left << setw(22) << "Connection" << right << setw(7) << "State" << setw(11) << "msg/s"
+         << setw(11) << "KB/s" << setw(13) << "Messages" << setw(11) << "MB" << setw(11) << "Reconnects"
+         << setw(8) << "Errors" << endl;
+    double total_rate = 0.0;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const ConnectionStats& s = *stats[i];
+        uint64_t messages = s.messages.load(memory_order_relaxed);
+        uint64_t bytes = s.bytes.load(memory_order_relaxed);
+        double rate = (messages - window_start[i].messages) / seconds;
+        total_rate += rate;
+        cout << left << setw(22) << s.name << right << setw(7) << (s.connected ? "up" : "DOWN")
+             << setw(11) << setprecision(1) << rate << setw(11) << (bytes - window_start[i].bytes) / 1024.0 / seconds
+             << setw(13) << messages << setw(11) << setprecision(2) << bytes / 1048576.0
+             << setw(11) << s.reconnects.load() << setw(8) << s.errors.load() << endl;
+        window_start[i] = {messages, bytes};
+    }
+    window_started = now;
+    cout << "Pool: " << (pool_running ? "RUNNING" : "STOPPED") << " on " << loops.size() << " I/O thread(s), "
+         << setprecision(1) << total_rate << " msg/s total" << endl;
+    cout << string(92, '=') << endl;
+}
@@ -0,0 +1,220 @@
+#include "fast_json_parser.hpp"
+#include "feed_decoder.hpp"
+#include "fast_orderbook.hpp"
+#include "json.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+#include <cstdio>
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace {
+
+// Depth payloads shaped like the live feeds: a random-walking mid with
+// 5-25 levels per side near the touch and ~30% deletions.
+vector<string> generate_payloads(Exchange venue, size_t count) {
+    mt19937 gen(7);
+    normal_distribution<double> walk(0.0, 0.35);
+    exponential_distribution<double> distance(0.25);
+    uniform_real_distribution<double> size(0.0001, 2.5);
+    uniform_int_distribution<int> levels_per_side(5, 25);
+    bernoulli_distribution deletion(0.3);
+
+    vector<string> payloads;
+    payloads.reserve(count);
+    double mid = 67123.45;
+    int64_t update_id = 40000000000;
+    int64_t ts = 1700000000000;
+
+    auto side = [&](bool is_bid) {
+        string out = "[";
+        int levels = levels_per_side(gen);
+        for (int i = 0; i < levels; ++i) {
+            double offset = 0.1 + round(distance(gen) * 10.0) / 10.0;
+            double price = round((is_bid ? mid - offset : mid + offset) * 10.0) / 10.0;
+            double qty = deletion(gen) ? 0.0 : round(size(gen) * 1000.0) / 1000.0;
+            char level[96];
+            if (venue == Exchange::OKX) {
+                snprintf(level, sizeof(level), "%s[\"%.1f\",\"%.3f\",\"0\",\"%d\"]", i ? "," : "", price, qty, qty > 0 ? 3 : 0);
+            } else {
+                snprintf(level, sizeof(level), "%s[\"%.2f\",\"%.8f\"]", i ? "," : "", price, qty);
+            }
+            out += level;
+        }
+        return out + "]";
+    };
+
+    for (size_t n = 0; n < count; ++n) {
+        mid += walk(gen);
+        int64_t first = update_id + 1;
+        update_id += 1 + n % 7;
+        ts += 100;
+        string bids = side(true);
+        string asks = side(false);
+        char header[256];
+        switch (venue) {
+        case Exchange::Binance:
+            snprintf(header, sizeof(header), "{\"stream\":\"btcusdt@depth\",\"data\":{\"e\":\"depthUpdate\",\"E\":%lld,\"s\":\"BTCUSDT\",\"U\":%lld,\"u\":%lld,",
+                     (long long)ts, (long long)first, (long long)update_id);
+            payloads.push_back(string(header) + "\"b\":" + bids + ",\"a\":" + asks + "}}");
+            break;
+        case Exchange::Bybit:
+            snprintf(header, sizeof(header), "{\"topic\":\"orderbook.50.BTCUSDT\",\"type\":\"%s\",\"ts\":%lld,\"data\":{\"s\":\"BTCUSDT\",",
+                     n == 0 ? "snapshot" : "delta", (long long)ts);
+            payloads.push_back(string(header) + "\"b\":" + bids + ",\"a\":" + asks +
+                               ",\"u\":" + to_string(update_id) + ",\"seq\":" + to_string(update_id * 3) +
+                               "},\"cts\":" + to_string(ts - 2) + "}");
+            break;
+        case Exchange::OKX:
+            snprintf(header, sizeof(header), "{\"arg\":{\"channel\":\"books\",\"instId\":\"BTC-USDT\"},\"action\":\"%s\",\"data\":[{",
+                     n == 0 ? "snapshot" : "update");
+            payloads.push_back(string(header) + "\"asks\":" + asks + ",\"bids\":" + bids +
+                               ",\"ts\":\"" + to_string(ts) + "\",\"checksum\":-1234567890,\"prevSeqId\":" +
+                               to_string(first - 1) + ",\"seqId\":" + to_string(update_id) + "}]}");
+            break;
+        }
+    }
+    return payloads;
+}
+
+// What the handlers did before: build the DOM, then walk it.
+void apply_dom(Exchange venue, const string& payload, FastOrderbook& book) {
+    json data = json::parse(payload);
+    auto apply_side = [&](const json& levels, bool is_bid) {
+        for (auto& level : levels) {
+            if (level.size() < 2) continue;
+            Price price = Price::parse(level[0].get_ref<const string&>());
+            Qty qty = Qty::parse(level[1].get_ref<const string&>());
+            if (is_bid) {
+                book.apply_bid(price, qty);
+            } else {
+                book.apply_ask(price, qty);
+            }
+        }
+    };
+
+    switch (venue) {
+    case Exchange::Binance:
+        if (data.contains("data") && data["data"].contains("b") && data["data"].contains("a")) {
+            apply_side(data["data"]["b"], true);
+            apply_side(data["data"]["a"], false);
+        }
+        break;
+    case Exchange::Bybit:
+        if (data.contains("data") && data["data"].contains("b") && data["data"].contains("a")) {
+            if (data.contains("type") && data["type"] == "snapshot") book.clear();
+            apply_side(data["data"]["b"], true);
+            apply_side(data["data"]["a"], false);
+        }
+        break;
+    case Exchange::OKX:
+        for (auto& book_data : data["data"]) {
+            if (data.contains("action") && data["action"] == "snapshot") book.clear();
+            apply_side(book_data["bids"], true);
+            apply_side(book_data["asks"], false);
+        }
+        break;
+    }
+}
+
+template<Exchange E>
+bool apply_streaming(const string& payload, FastOrderbook& book) {
+    using BookDecoder = Decoder<E, Channel::Depth>;
+    DepthMessage depth;
+    if (!BookDecoder::decode(payload.data(), payload.size(), depth)) return false;
+    if (depth.is_snapshot) book.clear();
+    return BookDecoder::apply(depth, book);
+}
+
+// The old single entry point: work out the venue from the payload on every
+// message, then decode. Kept only as the baseline for static binding.
+bool decode_sniffed(const string& payload, DepthMessage& out) {
+    if (payload.find("\"topic\":") != string::npos) {
+        return Decoder<Exchange::Bybit, Channel::Depth>::decode(payload.data(), payload.size(), out);
+    }
+    if (payload.find("\"arg\":") != string::npos) {
+        return Decoder<Exchange::OKX, Channel::Depth>::decode(payload.data(), payload.size(), out);
+    }
+    return Decoder<Exchange::Binance, Channel::Depth>::decode(payload.data(), payload.size(), out);
+}
+
+template<typename Fn>
+double ns_per_message(const vector<string>& payloads, int rounds, Fn&& fn) {
+    auto start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& payload : payloads) fn(payload);
+    }
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - start).count() /
+           double(payloads.size() * rounds);
+}
+
+template<Exchange E>
+void benchmark_venue(const char* name) {
+    using BookDecoder = Decoder<E, Channel::Depth>;
+    const size_t message_count = 20000;
+    const int rounds = 3;
+
+    auto payloads = generate_payloads(E, message_count);
+    size_t bytes = 0;
+    for (const auto& payload : payloads) bytes += payload.size();
+
+    auto dom_book = make_unique<FastOrderbook>(InstrumentSpec::make("0.1", "0.00000001"));
+    double dom_ns = ns_per_message(payloads, rounds, [&](const string& payload) {
+        apply_dom(E, payload, *dom_book);
+    });
+
+    // Header scan only, no level conversion. `sink` keeps the work live.
+    size_t sink = 0, decode_failures = 0;
+    DepthMessage depth;
+    double decode_ns = ns_per_message(payloads, rounds, [&](const string& payload) {
+        if (BookDecoder::decode(payload.data(), payload.size(), depth)) {
+            sink += depth.bids.size() + static_cast<size_t>(depth.last_update_id);
+        } else {
+            ++decode_failures;
+        }
+    });
+    double sniffed_ns = ns_per_message(payloads, rounds, [&](const string& payload) {
+        if (decode_sniffed(payload, depth)) sink += depth.bids.size() + static_cast<size_t>(depth.last_update_id);
+    });
+
+    auto fast_book = make_unique<FastOrderbook>(InstrumentSpec::make("0.1", "0.00000001"));
+    size_t failures = 0;
+    double fast_ns = ns_per_message(payloads, rounds, [&](const string& payload) {
+        if (!apply_streaming<E>(payload, *fast_book)) ++failures;
+    });
+
+    PriceLevel dom_levels[BookSnapshot::DEPTH], fast_levels[BookSnapshot::DEPTH];
+    bool books_match = dom_book->get_bid_count() == fast_book->get_bid_count() &&
+                       dom_book->get_ask_count() == fast_book->get_ask_count();
+    size_t n = dom_book->top_bids(BookSnapshot::DEPTH, dom_levels);
+    books_match &= n == fast_book->top_bids(BookSnapshot::DEPTH, fast_levels);
+    for (size_t i = 0; i < n && books_match; ++i) {
+        books_match = dom_levels[i].price == fast_levels[i].price && dom_levels[i].quantity == fast_levels[i].quantity;
+    }
+
+    cout << "Decoder<" << name << ", Depth> (" << bytes / message_count << " bytes/msg, "
+         << BookDecoder::layout::level_fields << " fields/level):" << endl;
+    cout << "  json::parse DOM + apply:    " << fixed << setprecision(0) << dom_ns << " ns/msg" << endl;
+    cout << "  sniff format + decode:      " << fixed << setprecision(0) << sniffed_ns << " ns/msg" << endl;
+    cout << "  static decode:              " << fixed << setprecision(0) << decode_ns << " ns/msg ("
+         << decode_failures / rounds << " rejected, checksum " << sink % 1000 << ")" << endl;
+    cout << "  static decode + apply:      " << fixed << setprecision(0) << fast_ns << " ns/msg"
+         << " (" << setprecision(2) << dom_ns / fast_ns << "x vs DOM, books "
+         << (books_match ? "match" : "DIFFER") << ", " << failures / rounds << " rejected)" << endl;
+}
+
+}
+
+void FastJsonParser::benchmark_against_dom() {
+    cout << "\n DEPTH DECODER BENCHMARK (per specialization, nlohmann DOM baseline)" << endl;
+    cout << string(60, '=') << endl;
+    benchmark_venue<Exchange::Binance>("Binance");
+    benchmark_venue<Exchange::Bybit>("Bybit");
+    benchmark_venue<Exchange::OKX>("OKX");
+    cout << string(60, '=') << endl;
+}
@@ -0,0 +1,413 @@
+#include "fast_orderbook.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <map>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+
+using namespace std;
+
+namespace {
+
+struct DepthLevel {
+    bool is_bid;
+    string price;
+    string quantity;
+};
+
+// Synthetic Binance btcusdt@depth bursts: a random-walking mid with most
+// updates landing within a few dollars of the touch and ~30% deletions.
+vector<vector<DepthLevel>> generate_depth_bursts(size_t message_count) {
+    mt19937 gen(42);
+    normal_distribution<double> walk(0.0, 0.35);
+    exponential_distribution<double> distance(0.25);
+    uniform_real_distribution<double> size(0.0001, 2.5);
+    uniform_int_distribution<int> levels_per_side(5, 25);
+    bernoulli_distribution deletion(0.3);
+
+    vector<vector<DepthLevel>> messages(message_count);
+    double mid = 67123.45;
+
+    for (auto& message : messages) {
+        mid += walk(gen);
+        for (int side = 0; side < 2; ++side) {
+            bool is_bid = side == 0;
+            int count = levels_per_side(gen);
+            for (int i = 0; i < count; ++i) {
+                double offset = 0.01 + round(distance(gen) * 100.0) / 100.0;
+                double price = round((is_bid ? mid - offset : mid + offset) * 100.0) / 100.0;
+                double qty = deletion(gen) ? 0.0 : round(size(gen) * 100000.0) / 100000.0;
+                char price_buf[32], qty_buf[32];
+                snprintf(price_buf, sizeof(price_buf), "%.2f", price);
+                snprintf(qty_buf, sizeof(qty_buf), "%.8f", qty);
+                message.push_back({is_bid, price_buf, qty_buf});
+            }
+        }
+    }
+    return messages;
+}
+
+struct ParsedLevel {
+    bool is_bid;
+    Price price;
+    Qty quantity;
+};
+
+struct ContentionResult {
+    double writer_messages_per_sec;
+    double reader_sweeps_per_sec;
+    double reader_p50_ns;
+    double reader_p99_ns;
+    double checksum;
+};
+
+// Runs `writers` feed threads, one book each, against `readers` threads that
+// sweep the mid of every book, for a fixed wall-clock window. WriteFn applies
+// one message to a book; ReadFn returns the mid of a book.
+template<typename WriteFn, typename ReadFn>
+ContentionResult run_contention(vector<unique_ptr<FastOrderbook>>& books,
+                                const vector<vector<ParsedLevel>>& messages,
+                                int readers, chrono::milliseconds window,
+                                WriteFn write_message, ReadFn read_mid) {
+    atomic<bool> stop{false};
+    vector<size_t> written(books.size(), 0);
+    vector<vector<int64_t>> sweep_ns(readers);
+    vector<double> checksums(readers, 0.0);
+    vector<thread> threads;
+
+    for (size_t w = 0; w < books.size(); ++w) {
+        threads.emplace_back([&, w]() {
+            FastOrderbook& book = *books[w];
+            size_t n = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                write_message(book, messages[(n + w * 97) % messages.size()]);
+                ++n;
+            }
+            written[w] = n;
+        });
+    }
+
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r]() {
+            auto& samples = sweep_ns[r];
+            samples.reserve(1 << 20);
+            double sum = 0.0;
+            while (!stop.load(memory_order_relaxed)) {
+                auto t0 = chrono::steady_clock::now();
+                for (const auto& book : books) sum += read_mid(*book).to_double();
+                auto t1 = chrono::steady_clock::now();
+                if (samples.size() < samples.capacity()) {
+                    samples.push_back(chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+                }
+            }
+            checksums[r] = sum;
+        });
+    }
+
+    this_thread::sleep_for(window);
+    stop = true;
+    for (auto& t : threads) t.join();
+
+    vector<int64_t> all;
+    for (auto& samples : sweep_ns) all.insert(all.end(), samples.begin(), samples.end());
+    sort(all.begin(), all.end());
+
+    size_t total_written = 0;
+    for (size_t n : written) total_written += n;
+    double seconds = chrono::duration<double>(window).count();
+
+    ContentionResult result{};
+    result.writer_messages_per_sec = total_written / seconds;
+    result.reader_sweeps_per_sec = all.size() / seconds;
+    result.reader_p50_ns = all.empty() ? 0.0 : all[all.size() / 2];
+    result.reader_p99_ns = all.empty() ? 0.0 : all[all.size() * 99 / 100];
+    for (double c : checksums) result.checksum += c;
+    return result;
+}
+
+}
+
+void FastOrderbook::benchmark_against_map() {
+    cout << "\n ORDERBOOK UPDATE BENCHMARK (Binance diff-depth bursts)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t message_count = 20000;
+    const int rounds = 5;
+    auto messages = generate_depth_bursts(message_count);
+
+    size_t level_updates = 0;
+    for (const auto& message : messages) level_updates += message.size();
+    level_updates *= rounds;
+
+    map<double, string> map_bids, map_asks;
+    double map_checksum = 0.0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        map_bids.clear();
+        map_asks.clear();
+        for (const auto& message : messages) {
+            for (const auto& level : message) {
+                auto& side = level.is_bid ? map_bids : map_asks;
+                double price = stod(level.price);
+                string qty = level.quantity;
+                if (stod(qty) == 0.0) {
+                    side.erase(price);
+                } else {
+                    side[price] = qty;
+                }
+            }
+            if (!map_bids.empty() && !map_asks.empty()) {
+                map_checksum += map_bids.rbegin()->first - map_asks.begin()->first;
+            }
+        }
+    }
+    auto map_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::high_resolution_clock::now() - start).count();
+
+    auto book = make_unique<FastOrderbook>(InstrumentSpec::make("0.01", "0.00001"));
+    double flat_checksum = 0.0;
+    start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        book->clear();
+        for (const auto& message : messages) {
+            for (const auto& level : message) {
+                Price price = Price::parse(level.price);
+                Qty qty = Qty::parse(level.quantity);
+                if (level.is_bid) {
+                    book->apply_bid(price, qty);
+                } else {
+                    book->apply_ask(price, qty);
+                }
+            }
+            if (book->has_quotes()) {
+                flat_checksum += (book->get_best_bid().price - book->get_best_ask().price).to_double();
+            }
+        }
+    }
+    auto flat_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::high_resolution_clock::now() - start).count();
+
+    double map_per_level = static_cast<double>(map_ns) / level_updates;
+    double flat_per_level = static_cast<double>(flat_ns) / level_updates;
+
+    cout << "Messages: " << message_count * rounds << ", level updates: " << level_updates << endl;
+    cout << "map<double,string>:  " << fixed << setprecision(1) << map_per_level << " ns/level (stod + string qty)" << endl;
+    cout << "FastOrderbook:       " << fixed << setprecision(1) << flat_per_level << " ns/level (fixed-point parse)" << endl;
+    cout << "Speedup: " << fixed << setprecision(2) << (map_per_level / flat_per_level) << "x" << endl;
+    cout << "Final top of book: map " << setprecision(2) << map_bids.rbegin()->first << "/" << map_asks.begin()->first
+         << ", flat " << book->get_best_bid().price.to_double() << "/" << book->get_best_ask().price.to_double()
+         << " (checksums " << (abs(map_checksum - flat_checksum) < 1e-3 ? "match" : "DIFFER") << ")" << endl;
+    cout << string(60, '=') << endl;
+}
+
+void FastOrderbook::benchmark_reader_contention() {
+    cout << "\n BOOK READER CONTENTION BENCHMARK (global mutex vs per-book seqlock)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t writers = 12;
+    const int readers = 3;
+    const auto window = chrono::milliseconds(1000);
+
+    vector<vector<ParsedLevel>> messages;
+    for (const auto& burst : generate_depth_bursts(2000)) {
+        vector<ParsedLevel> parsed;
+        for (const auto& level : burst) {
+            parsed.push_back({level.is_bid, Price::parse(level.price), Qty::parse(level.quantity)});
+        }
+        messages.push_back(move(parsed));
+    }
+
+    auto make_books = [&]() {
+        vector<unique_ptr<FastOrderbook>> books;
+        for (size_t i = 0; i < writers; ++i) {
+            books.push_back(make_unique<FastOrderbook>(InstrumentSpec::make("0.01", "0.00001")));
+        }
+        return books;
+    };
+
+    auto apply = [](FastOrderbook& book, const vector<ParsedLevel>& message) {
+        for (const auto& level : message) {
+            if (level.is_bid) {
+                book.apply_bid(level.price, level.quantity);
+            } else {
+                book.apply_ask(level.price, level.quantity);
+            }
+        }
+    };
+
+    mutex global_mutex;
+    auto mutex_books = make_books();
+    ContentionResult locked = run_contention(mutex_books, messages, readers, window,
+        [&](FastOrderbook& book, const vector<ParsedLevel>& message) {
+            lock_guard<mutex> lock(global_mutex);
+            apply(book, message);
+        },
+        [&](const FastOrderbook& book) {
+            lock_guard<mutex> lock(global_mutex);
+            return book.mid_price();
+        });
+
+    auto seqlock_books = make_books();
+    ContentionResult lock_free = run_contention(seqlock_books, messages, readers, window,
+        [&](FastOrderbook& book, const vector<ParsedLevel>& message) {
+            apply(book, message);
+            book.publish();
+        },
+        [](const FastOrderbook& book) {
+            return book.snapshot().mid_price();
+        });
+
+    auto report = [](const string& name, const ContentionResult& r) {
+        cout << name << fixed << setprecision(0)
+             << r.writer_messages_per_sec << " msgs/s written, "
+             << r.reader_sweeps_per_sec << " sweeps/s read, sweep p50 "
+             << r.reader_p50_ns << " ns, p99 " << r.reader_p99_ns << " ns" << endl;
+    };
+
+    cout << "Writers: " << writers << " (one book each), readers: " << readers
+         << ", window: " << window.count() << " ms, hardware threads: " << thread::hardware_concurrency() << endl;
+    report("global mutex:  ", locked);
+    report("seqlock:       ", lock_free);
+    cout << "Writer throughput seqlock/mutex: " << fixed << setprecision(2)
+         << (lock_free.writer_messages_per_sec / max(locked.writer_messages_per_sec, 1.0)) << "x, "
+         << "reader p99 mutex/seqlock: " << (locked.reader_p99_ns / max(lock_free.reader_p99_ns, 1.0)) << "x" << endl;
+    if (thread::hardware_concurrency() < writers + readers) {
+        cout << "Note: fewer cores than threads, so this measures time slicing rather than lock contention" << endl;
+    }
+    cout << string(60, '=') << endl;
+}
+
+uint32_t FastOrderbook::export_bands(const PriceLevelArray& side, bool is_bid, const PriceLevel* levels, size_t depth,
+                                     DepthPoint* out) const {
+    if (depth == 0) return 0;
+    int64_t quantity = 0;
+    for (size_t i = 0; i < depth; ++i) quantity += levels[i].quantity.raw;
+
+    // One tick times one raw unit of quantity, in price * quantity.
+    double tick_notional = instrument.tick_size.to_double() / FIXED_POINT_SCALE;
+    int64_t best = side.best_tick();
+    int64_t last = instrument.to_ticks(levels[depth - 1].price);
+    int64_t limits[BookSnapshot::BANDS];
+    for (size_t b = 0; b < BookSnapshot::BANDS; ++b) {
+        int64_t reach = max<int64_t>(1, llround(best * BookSnapshot::BAND_BPS[b] / 10000.0));
+        limits[b] = is_bid ? best - reach : best + reach;
+    }
+    PriceLevelArray::Depth bands[BookSnapshot::BANDS];
+    size_t answered = side.depth_to(limits, BookSnapshot::BANDS, bands);
+    uint32_t written = 0;
+    for (size_t b = 0; b < answered; ++b) {
+        if ((is_bid ? limits[b] >= last : limits[b] <= last) || bands[b].quantity <= quantity) continue;
+        quantity = bands[b].quantity;
+        out[written++] = {Qty(quantity).to_double(), static_cast<double>(bands[b].tick_notional) * tick_notional};
+    }
+    return written;
+}
+
+ExecutableEdge executable_edge(const ExecutionLeg& buy, const ExecutionLeg& sell, double min_edge) {
+    ExecutableEdge result;
+    DepthPoint asks[BookSnapshot::CURVE];
+    DepthPoint bids[BookSnapshot::CURVE];
+    uint32_t ask_points = buy.book.ask_curve(asks);
+    uint32_t bid_points = sell.book.bid_curve(bids);
+
+    // Each curve segment is a slice at its own average price; *_left is
+    // what remains of the current one, in the underlying.
+    DepthPoint ask_from, bid_from;
+    uint32_t i = 0, j = 0;
+    double ask_left = ask_points ? asks[0].quantity * buy.multiplier : 0.0;
+    double bid_left = bid_points ? bids[0].quantity * sell.multiplier : 0.0;
+    while (i < ask_points && j < bid_points) {
+        double ask_price = (asks[i].notional - ask_from.notional) / (asks[i].quantity - ask_from.quantity) *
+                           buy.price_factor;
+        double bid_price = (bids[j].notional - bid_from.notional) / (bids[j].quantity - bid_from.quantity) *
+                           sell.price_factor;
+        if (bid_price / ask_price - 1.0 <= min_edge) break;
+
+        double take = min(ask_left, bid_left);
+        result.quantity += take;
+        result.cost += take * ask_price;
+        result.proceeds += take * bid_price;
+        if (ask_left <= bid_left) {
+            bid_left -= take;
+            ask_from = asks[i++];
+            if (i < ask_points) ask_left = (asks[i].quantity - ask_from.quantity) * buy.multiplier;
+        } else {
+            ask_left -= take;
+            bid_from = bids[j++];
+            if (j < bid_points) bid_left = (bids[j].quantity - bid_from.quantity) * sell.multiplier;
+        }
+    }
+    return result;
+}
+
+// Depth out to a random limit price, from the prefix sums against walking
+// the levels up to it, on a book built from the update benchmark's bursts;
+// then what publishing the depth curve adds per message.
+void FastOrderbook::benchmark_depth_queries() {
+    cout << "\n DEPTH QUERY BENCHMARK (prefix sums vs level walk)" << endl;
+    cout << string(60, '=') << endl;
+
+    auto messages = generate_depth_bursts(20000);
+    auto book = make_unique<FastOrderbook>(InstrumentSpec::make("0.01", "0.00001"));
+    auto apply = [&](const vector<DepthLevel>& message) {
+        for (const auto& level : message) {
+            Price price = Price::parse(level.price);
+            Qty qty = Qty::parse(level.quantity);
+            if (level.is_bid) {
+                book->apply_bid(price, qty);
+            } else {
+                book->apply_ask(price, qty);
+            }
+        }
+    };
+    for (const auto& message : messages) apply(message);
+
+    const PriceLevelArray& side = book->asks;
+    const size_t queries = 200000;
+    mt19937 gen(9);
+    uniform_int_distribution<int64_t> reach(0, 2000);
+    vector<int64_t> limits(queries);
+    vector<size_t> walk_levels(queries);
+    for (size_t n = 0; n < queries; ++n) {
+        limits[n] = side.best_tick() + reach(gen);
+        size_t levels = 0;
+        side.for_each_level(side.size(), [&](size_t, int64_t tick, int64_t) { levels += tick <= limits[n]; });
+        walk_levels[n] = levels;
+    }
+
+    int64_t walk_sum = 0;
+    size_t walked = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (size_t n = 0; n < queries; ++n) {
+        walked += side.for_each_level(walk_levels[n], [&](size_t, int64_t, int64_t qty) { walk_sum += qty; });
+    }
+    auto t1 = chrono::steady_clock::now();
+    int64_t tree_sum = 0;
+    for (size_t n = 0; n < queries; ++n) tree_sum += side.depth_to(limits[n]).quantity;
+    auto t2 = chrono::steady_clock::now();
+
+    const size_t publishes = 20000;
+    auto t3 = chrono::steady_clock::now();
+    for (size_t n = 0; n < publishes; ++n) book->publish();
+    auto t4 = chrono::steady_clock::now();
+    BookSnapshot snap = book->snapshot();
+    DepthPoint curve[BookSnapshot::CURVE];
+    uint32_t points = snap.ask_curve(curve);
+    DepthFill fill = snap.buy(points ? curve[points - 1].quantity / 2 : 0.0);
+
+    auto ns = [](chrono::steady_clock::duration d, size_t count) {
+        return chrono::duration<double, nano>(d).count() / count;
+    };
+    cout << "Ask side: " << side.size() << " levels, " << queries << " queries, " << fixed << setprecision(1)
+         << walked / double(queries) << " levels to each limit on average" << endl;
+    cout << "Level walk:   " << setw(8) << ns(t1 - t0, queries) << " ns/query" << endl;
+    cout << "Prefix sums:  " << setw(8) << ns(t2 - t1, queries) << " ns/query" << endl;
+    cout << "Publish with " << snap.ask_band_count << " ask bands: " << ns(t4 - t3, publishes) << " ns" << endl;
+    cout << "VWAP to buy " << setprecision(4) << fill.quantity << ": $" << setprecision(2) << fill.vwap()
+         << " against best ask $" << snap.best_ask().price.to_double() << endl;
+    cout << "Depth totals " << (walk_sum == tree_sum ? "match" : "DIFFER") << endl;
+    cout << string(60, '=') << endl;
+}
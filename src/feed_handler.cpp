@@ -0,0 +1,175 @@
+#include "feed_handler.hpp"
+#include <cctype>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+string lowercase(string text) {
+    for (auto& c : text) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return text;
+}
+
+string uppercase(string text) {
+    for (auto& c : text) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    return text;
+}
+
+}
+
+string feed_tag(const InstrumentInfo& info) {
+    return "[" + uppercase(exchange_name(info.exchange)) + " " + asset_code(info.asset) + " " +
+           uppercase(market_name(info.market)) + "]";
+}
+
+string session_tag(Exchange exchange, MarketType market) {
+    return "[" + uppercase(exchange_name(exchange)) + " " + uppercase(market_name(market)) + "]";
+}
+
+bool is_perpetual(const InstrumentInfo& info) {
+    return instrument_metadata.get(info.id).perpetual();
+}
+
+// wss://stream.binance.com:9443/stream?streams=btcusdt@depth/ethusdt@depth
+// Spot also listens on :443, which the second leg uses.
+string BinanceFeed::uri(MarketType market, const vector<const InstrumentInfo*>& instruments, int leg, bool bbo,
+                        bool funding) {
+    string uri = market == MarketType::Futures ? "wss://fstream.binance.com/stream?streams="
+                 : leg == 0                    ? "wss://stream.binance.com:9443/stream?streams="
+                                               : "wss://stream.binance.com:443/stream?streams=";
+    for (size_t i = 0; i < instruments.size(); ++i) {
+        if (i) uri += '/';
+        string symbol = lowercase(instruments[i]->symbol);
+        uri += symbol + "@depth";
+        if (bbo) uri += '/' + symbol + "@bookTicker";
+        if (funding && is_perpetual(*instruments[i])) uri += '/' + symbol + "@markPrice";
+    }
+    return uri;
+}
+
+vector<string> BinanceFeed::subscribe_messages(const vector<const InstrumentInfo*>&, bool, bool) {
+    return {};
+}
+
+bool BinanceFeed::is_ticker(string_view channel) {
+    static constexpr string_view suffix = "@bookTicker";
+    return channel.size() > suffix.size() && channel.substr(channel.size() - suffix.size()) == suffix;
+}
+
+bool BinanceFeed::is_funding(string_view channel) {
+    static constexpr string_view suffix = "@markPrice";
+    return channel.size() > suffix.size() && channel.substr(channel.size() - suffix.size()) == suffix;
+}
+
+string BinanceFeed::snapshot_host(MarketType market) {
+    return market == MarketType::Futures ? "fapi.binance.com" : "api.binance.com";
+}
+
+// 1000 levels comfortably covers what the diffs buffered during the fetch touch.
+string BinanceFeed::snapshot_target(const InstrumentInfo& info) {
+    string path = info.market == MarketType::Futures ? "/fapi/v1/depth" : "/api/v3/depth";
+    return path + "?symbol=" + uppercase(info.symbol) + "&limit=1000";
+}
+
+string BybitFeed::uri(MarketType market, const vector<const InstrumentInfo*>&, int, bool, bool) {
+    return market == MarketType::Spot ? "wss://stream.bybit.com/v5/public/spot"
+                                      : "wss://stream.bybit.com/v5/public/linear";
+}
+
+namespace {
+
+constexpr string_view BYBIT_TICKER_PREFIX = "orderbook.1.";
+constexpr string_view BYBIT_FUNDING_PREFIX = "tickers.";
+constexpr string_view OKX_TICKER_CHANNEL = "bbo-tbt";
+constexpr string_view OKX_FUNDING_CHANNEL = "funding-rate";
+constexpr string_view OKX_MARK_CHANNEL = "mark-price";
+
+string bybit_topic(const InstrumentInfo& info) {
+    return "\"orderbook.50." + info.symbol + "\"";
+}
+
+string bybit_ticker_topic(const InstrumentInfo& info) {
+    return "\"" + string(BYBIT_TICKER_PREFIX) + info.symbol + "\"";
+}
+
+string bybit_funding_topic(const InstrumentInfo& info) {
+    return "\"" + string(BYBIT_FUNDING_PREFIX) + info.symbol + "\"";
+}
+
+string okx_arg(const InstrumentInfo& info, string_view channel = "books") {
+    return "{\"channel\":\"" + string(channel) + "\",\"instId\":\"" + info.symbol + "\"}";
+}
+
+}
+
+// Bybit spot rejects more than 10 args per subscribe request, so topics go
+// out in batches of 10.
+vector<string> BybitFeed::subscribe_messages(const vector<const InstrumentInfo*>& instruments, bool bbo,
+                                             bool funding) {
+    vector<string> topics;
+    for (const auto* info : instruments) {
+        topics.push_back(bybit_topic(*info));
+        if (bbo) topics.push_back(bybit_ticker_topic(*info));
+        if (funding && is_perpetual(*info)) topics.push_back(bybit_funding_topic(*info));
+    }
+
+    const size_t batch = 10;
+    vector<string> messages;
+    for (size_t start = 0; start < topics.size(); start += batch) {
+        string message = "{\"op\":\"subscribe\",\"args\":[";
+        for (size_t i = start; i < min(start + batch, topics.size()); ++i) {
+            if (i != start) message += ',';
+            message += topics[i];
+        }
+        messages.push_back(message + "]}");
+    }
+    return messages;
+}
+
+bool BybitFeed::is_ticker(string_view channel) {
+    return channel.substr(0, BYBIT_TICKER_PREFIX.size()) == BYBIT_TICKER_PREFIX;
+}
+
+bool BybitFeed::is_funding(string_view channel) {
+    return channel.substr(0, BYBIT_FUNDING_PREFIX.size()) == BYBIT_FUNDING_PREFIX;
+}
+
+// Resubscribing makes Bybit send a fresh snapshot for just this topic.
+vector<string> BybitFeed::resync_messages(const InstrumentInfo& info) {
+    return {"{\"op\":\"unsubscribe\",\"args\":[" + bybit_topic(info) + "]}",
+            "{\"op\":\"subscribe\",\"args\":[" + bybit_topic(info) + "]}"};
+}
+
+// The second leg goes through OKX's AWS edge.
+string OkxFeed::uri(MarketType, const vector<const InstrumentInfo*>&, int leg, bool, bool) {
+    return leg == 0 ? "wss://ws.okx.com:8443/ws/v5/public" : "wss://wsaws.okx.com:8443/ws/v5/public";
+}
+
+vector<string> OkxFeed::subscribe_messages(const vector<const InstrumentInfo*>& instruments, bool bbo,
+                                           bool funding) {
+    string message = "{\"op\":\"subscribe\",\"args\":[";
+    for (size_t i = 0; i < instruments.size(); ++i) {
+        if (i) message += ',';
+        message += okx_arg(*instruments[i]);
+        if (bbo) message += ',' + okx_arg(*instruments[i], OKX_TICKER_CHANNEL);
+        if (funding && is_perpetual(*instruments[i])) {
+            message += ',' + okx_arg(*instruments[i], OKX_FUNDING_CHANNEL);
+            message += ',' + okx_arg(*instruments[i], OKX_MARK_CHANNEL);
+        }
+    }
+    return {message + "]}"};
+}
+
+bool OkxFeed::is_ticker(string_view channel) {
+    return channel == OKX_TICKER_CHANNEL;
+}
+
+bool OkxFeed::is_funding(string_view channel) {
+    return channel == OKX_FUNDING_CHANNEL || channel == OKX_MARK_CHANNEL;
+}
+
+vector<string> OkxFeed::resync_messages(const InstrumentInfo& info) {
+    return {"{\"op\":\"unsubscribe\",\"args\":[" + okx_arg(info) + "]}",
+            "{\"op\":\"subscribe\",\"args\":[" + okx_arg(info) + "]}"};
+}
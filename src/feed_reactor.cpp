@@ -0,0 +1,328 @@
+#include "feed_reactor.hpp"
+#include "feed_handler.hpp"
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <sys/resource.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+unique_ptr<FeedConnector> make_handler(Exchange exchange, ConnectionPool& pool, boost::asio::io_service& io,
+                                       const vector<InstrumentId>& instruments, const FeedConfig& config,
+                                       BookPipeline* pipeline) {
+    switch (exchange) {
+    case Exchange::Binance: return make_unique<FeedHandler<BinanceFeed>>(pool, io, instruments, config, pipeline);
+    case Exchange::Bybit: return make_unique<FeedHandler<BybitFeed>>(pool, io, instruments, config, pipeline);
+    case Exchange::OKX: return make_unique<FeedHandler<OkxFeed>>(pool, io, instruments, config, pipeline);
+    }
+    return nullptr;
+}
+
+}
+
+FeedReactor::FeedReactor(ConnectionPool& connection_pool, const FeedConfig& feed_config)
+    : config(feed_config), pool(connection_pool) {
+    // One session (connection) per exchange and market in use.
+    const size_t session_slots = EXCHANGE_COUNT * MARKET_TYPE_COUNT;
+    vector<vector<InstrumentId>> sessions(session_slots);
+    for (const auto& info : instrument_registry.all()) {
+        sessions[static_cast<size_t>(info.exchange) * MARKET_TYPE_COUNT + static_cast<size_t>(info.market)].push_back(info.id);
+    }
+    size_t session_total = 0;
+    for (const auto& session : sessions) session_total += !session.empty();
+    shards = max<size_t>(min(pool.io_count(), session_total), 1);
+
+    // Sessions are dealt round-robin; a shard gets one handler per exchange
+    // covering whichever of that exchange's sessions landed on it.
+    vector<vector<InstrumentId>> groups(shards * EXCHANGE_COUNT);
+    size_t next_shard = 0;
+    for (size_t slot = 0; slot < session_slots; ++slot) {
+        if (sessions[slot].empty()) continue;
+        auto& group = groups[next_shard * EXCHANGE_COUNT + slot / MARKET_TYPE_COUNT];
+        group.insert(group.end(), sessions[slot].begin(), sessions[slot].end());
+        next_shard = (next_shard + 1) % shards;
+    }
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if (groups[g].empty()) continue;
+        handlers.push_back(make_handler(static_cast<Exchange>(g % EXCHANGE_COUNT), pool, pool.io(g / EXCHANGE_COUNT),
+                                        groups[g], config, config.book_pipeline ? &pipeline : nullptr));
+    }
+}
+
+FeedReactor::~FeedReactor() {
+    stop();
+}
+
+void FeedReactor::start() {
+    if (config.book_pipeline) pipeline.start();
+    size_t stream_total = 0;
+    for (auto& handler : handlers) {
+        handler->start();
+        stream_total += handler->stream_count();
+    }
+    cout << "[FEED REACTOR] " << stream_total << " streams on " << shards << " I/O thread(s)"
+         << (config.book_pipeline ? ", books on the book thread" : "") << endl;
+}
+
+void FeedReactor::stop() {
+    pool.stop_all_connections();
+    pipeline.stop();
+}
+
+vector<FeedHealth> FeedReactor::health() const {
+    vector<FeedHealth> out;
+    for (const auto& handler : handlers) handler->collect_health(out);
+    return out;
+}
+
+void FeedReactor::print_feed_health() const {
+    cout << "\n[FEED HEALTH]" << endl;
+    cout << left << setw(20) << "Session" << right << setw(7) << "State" << setw(9) << "Standby"
+         << setw(9) << "Outages" << setw(14) << "Down (ms)" << setw(14) << "Last (ms)"
+         << setw(12) << "Reconnects" << setw(11) << "Failovers" << setw(7) << "Gaps"
+         << setw(7) << "Cksum"
+         << setw(20) << "Resync avg/max (ms)" << endl;
+    for (const auto& h : health()) {
+        cout << left << setw(20) << h.session << right << setw(7) << (h.up ? "up" : "DOWN")
+             << setw(9) << (h.standby_ready ? "ready" : "-") << setw(9) << h.outages
+             << setw(14) << fixed << setprecision(1) << h.downtime_ns / 1e6
+             << setw(14) << h.last_outage_ns / 1e6 << setw(12) << h.reconnects << setw(11) << h.failovers
+             << setw(7) << h.sequence_gaps << setw(7) << h.checksum_failures << setw(12) << (h.resyncs ? h.resync_ns_total / 1e6 / h.resyncs : 0.0)
+             << " /" << setw(6) << h.resync_ns_max / 1e6 << endl;
+    }
+
+    for (const auto& h : health()) {
+        if (!h.ab_arbitration) continue;
+        uint64_t total = h.leg_wins[0] + h.leg_wins[1];
+        cout << left << setw(20) << h.session << right;
+        for (int leg = 0; leg < 2; ++leg) {
+            double share = total ? 100.0 * h.leg_wins[leg] / total : 0.0;
+            double lead_us = h.leg_lead_samples[leg] ? h.leg_lead_ns[leg] / 1e3 / h.leg_lead_samples[leg] : 0.0;
+            cout << "  leg " << (leg == 0 ? "A" : "B") << " wins " << fixed << setprecision(1) << share
+                 << "% (leads by " << lead_us << " us)";
+        }
+        cout << "  dups " << h.duplicates << endl;
+    }
+
+    for (const auto& h : health()) {
+        if (!h.bbo_channels) continue;
+        uint64_t total = h.bbo_wins[0] + h.bbo_wins[1];
+        cout << left << setw(20) << h.session << right << "  BBO first:";
+        for (size_t source = 0; source < BBO_SOURCE_COUNT; ++source) {
+            double share = total ? 100.0 * h.bbo_wins[source] / total : 0.0;
+            double lead_ms = h.bbo_lead_samples[source] ? h.bbo_lead_ns[source] / 1e6 / h.bbo_lead_samples[source] : 0.0;
+            cout << "  " << bbo_source_name(static_cast<BboSource>(source)) << " " << fixed << setprecision(1)
+                 << share << "% (leads by " << setprecision(2) << lead_ms << " ms)";
+        }
+        cout << "  changes " << total << endl;
+    }
+
+    for (const auto& h : health()) {
+        if (!h.funding_channels || h.funding_updates == 0) continue;
+        cout << left << setw(20) << h.session << right << "  Funding updates " << h.funding_updates
+             << ", rate changes " << h.funding_rate_changes << endl;
+    }
+
+    if (config.book_pipeline) pipeline.print_stats();
+}
+
+namespace {
+
+using boost::asio::local::stream_protocol;
+using BenchDecoder = Decoder<Exchange::Binance, Channel::Depth>;
+
+struct FrameHeader {
+    uint32_t length;
+    int64_t sent_ns;
+};
+
+int64_t steady_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long thread_context_switches() {
+#ifdef RUSAGE_THREAD
+    rusage usage{};
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+#else
+    return 0;
+#endif
+}
+
+// One simulated feed: the read end of a socketpair on some reactor, and
+// the book its messages land in. Messages go through the same decode,
+// apply and publish steps as a live FeedHandler.
+struct BenchStream {
+    stream_protocol::socket socket;
+    FastOrderbook book;
+    FrameHeader header{};
+    vector<char> payload;
+    vector<int64_t> latencies;
+    atomic<size_t>* outstanding;
+
+    BenchStream(boost::asio::io_service& io, atomic<size_t>* counter)
+        : socket(io), book(InstrumentSpec::make("0.01", "0.00001")), outstanding(counter) {}
+};
+
+void read_frame(BenchStream& s) {
+    boost::asio::async_read(s.socket, boost::asio::buffer(&s.header, sizeof(s.header)),
+        [&s](const boost::system::error_code& ec, size_t) {
+            if (ec) return;
+            s.payload.resize(s.header.length);
+            boost::asio::async_read(s.socket, boost::asio::buffer(s.payload),
+                [&s](const boost::system::error_code& ec, size_t) {
+                    if (ec) return;
+                    DepthMessage depth;
+                    if (BenchDecoder::decode(s.payload.data(), s.payload.size(), depth)) {
+                        BenchDecoder::apply(depth, s.book);
+                        s.book.publish();
+                    }
+                    s.latencies.push_back(steady_ns() - s.header.sent_ns);
+                    s.outstanding->fetch_sub(1, memory_order_relaxed);
+                    read_frame(s);
+                });
+        });
+}
+
+vector<string> bench_payloads(size_t count) {
+    mt19937 gen(11);
+    uniform_real_distribution<double> qty(0.0, 2.0);
+    vector<string> payloads;
+    double mid = 67000.0;
+    for (size_t n = 0; n < count; ++n) {
+        mid += (n % 3 == 0) ? 0.5 : -0.25;
+        string bids = "[", asks = "[";
+        for (int i = 0; i < 8; ++i) {
+            char level[64];
+            snprintf(level, sizeof(level), "%s[\"%.2f\",\"%.5f\"]", i ? "," : "", mid - 0.01 * (i + 1), qty(gen));
+            bids += level;
+            snprintf(level, sizeof(level), "%s[\"%.2f\",\"%.5f\"]", i ? "," : "", mid + 0.01 * (i + 1), qty(gen));
+            asks += level;
+        }
+        payloads.push_back("{\"e\":\"depthUpdate\",\"E\":1700000000000,\"s\":\"BTCUSDT\",\"U\":" + to_string(n * 2 + 1) +
+                           ",\"u\":" + to_string(n * 2 + 2) + ",\"b\":" + bids + "],\"a\":" + asks + "]}");
+    }
+    return payloads;
+}
+
+struct LayoutResult {
+    size_t threads = 0;
+    long context_switches = 0;
+    double p50_us = 0, p99_us = 0, max_us = 0;
+    size_t delivered = 0;
+    bool complete = false;
+};
+
+// Pushes `bursts` rounds of one message per stream through socketpairs and
+// measures what the reactor threads pay to receive them. shard_count 0 is
+// the one-thread-per-stream layout.
+LayoutResult run_layout(size_t stream_count, size_t shard_count, const vector<string>& payloads, size_t bursts,
+                        chrono::microseconds gap) {
+    size_t io_count = shard_count == 0 ? stream_count : shard_count;
+    vector<unique_ptr<boost::asio::io_service>> shards;
+    for (size_t s = 0; s < io_count; ++s) shards.push_back(make_unique<boost::asio::io_service>(1));
+
+    boost::asio::io_service writer_io;
+    atomic<size_t> outstanding{stream_count * bursts};
+    vector<unique_ptr<BenchStream>> streams;
+    vector<unique_ptr<stream_protocol::socket>> writers;
+    for (size_t i = 0; i < stream_count; ++i) {
+        streams.push_back(make_unique<BenchStream>(*shards[i % io_count], &outstanding));
+        streams.back()->latencies.reserve(bursts);
+        writers.push_back(make_unique<stream_protocol::socket>(writer_io));
+        boost::asio::local::connect_pair(streams.back()->socket, *writers.back());
+        read_frame(*streams.back());
+    }
+
+    atomic<long> switches{0};
+    vector<thread> threads;
+    for (auto& shard : shards) {
+        threads.emplace_back([&switches, io = shard.get()]() {
+            long before = thread_context_switches();
+            io->run();
+            switches += thread_context_switches() - before;
+        });
+    }
+
+    auto next = chrono::steady_clock::now();
+    for (size_t b = 0; b < bursts; ++b) {
+        for (size_t i = 0; i < stream_count; ++i) {
+            const string& payload = payloads[(b * stream_count + i) % payloads.size()];
+            FrameHeader header{static_cast<uint32_t>(payload.size()), steady_ns()};
+            array<boost::asio::const_buffer, 2> frame = {boost::asio::buffer(&header, sizeof(header)),
+                                                        boost::asio::buffer(payload)};
+            boost::asio::write(*writers[i], frame);
+        }
+        next += gap;
+        this_thread::sleep_until(next);
+    }
+
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (outstanding.load() != 0 && chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    LayoutResult result;
+    result.complete = outstanding.load() == 0;
+    // EOF on every read end lets each io_service run out of work.
+    for (auto& writer : writers) writer->close();
+    if (!result.complete) {
+        for (auto& shard : shards) shard->stop();
+    }
+    for (auto& t : threads) t.join();
+
+    vector<int64_t> latencies;
+    for (auto& stream : streams) latencies.insert(latencies.end(), stream->latencies.begin(), stream->latencies.end());
+    sort(latencies.begin(), latencies.end());
+    result.threads = io_count;
+    result.context_switches = switches.load();
+    result.delivered = latencies.size();
+    if (!latencies.empty()) {
+        result.p50_us = latencies[latencies.size() / 2] / 1000.0;
+        result.p99_us = latencies[latencies.size() * 99 / 100] / 1000.0;
+        result.max_us = latencies.back() / 1000.0;
+    }
+    return result;
+}
+
+}
+
+void FeedReactor::benchmark_reactor_layouts() {
+    cout << "\n FEED REACTOR LAYOUT BENCHMARK (thread per stream vs shared io_service)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t stream_count = 12;
+    const size_t bursts = 2000;
+    const auto gap = chrono::microseconds(250);
+    auto payloads = bench_payloads(64);
+
+    cout << stream_count << " streams, " << bursts << " bursts of one depth message per stream every "
+         << gap.count() << " us" << endl;
+#ifndef RUSAGE_THREAD
+    cout << "(RUSAGE_THREAD unavailable: context switches not measured)" << endl;
+#endif
+
+    const pair<size_t, const char*> layouts[] = {
+        {0, "thread per stream"}, {1, "1 shared reactor"}, {2, "2 reactor shards"}, {3, "3 reactor shards"}};
+    for (const auto& [shards, name] : layouts) {
+        LayoutResult r = run_layout(stream_count, shards, payloads, bursts, gap);
+        cout << left << setw(20) << name << right << " threads " << setw(2) << r.threads
+             << "  ctx switches " << setw(6) << r.context_switches
+             << " (" << fixed << setprecision(2) << r.context_switches / double(bursts) << "/burst)"
+             << "  latency p50 " << setprecision(1) << r.p50_us << " us, p99 " << r.p99_us
+             << " us, max " << r.max_us << " us" << (r.complete ? "" : "  INCOMPLETE") << endl;
+    }
+    cout << string(60, '=') << endl;
+}
@@ -0,0 +1,182 @@
+#include "fixed_point.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// Decimal strings in the shapes the venues send: 1-2 decimal prices, 3-8
+// decimal sizes, bare integers (OKX contract counts) and a few long ones
+// that must fall back to the scalar path.
+vector<string> generate_decimals(size_t count) {
+    mt19937_64 gen(11);
+    uniform_real_distribution<double> price(0.01, 999999.99);
+    uniform_real_distribution<double> size(0.0, 250.0);
+    uniform_int_distribution<int> shape(0, 9);
+    uniform_int_distribution<int> decimals(0, 8);
+
+    vector<string> out;
+    out.reserve(count);
+    char buf[64];
+    for (size_t i = 0; i < count; ++i) {
+        switch (shape(gen)) {
+        case 0: case 1: case 2:
+            snprintf(buf, sizeof(buf), "%.2f", price(gen));
+            break;
+        case 3:
+            snprintf(buf, sizeof(buf), "%.1f", price(gen));
+            break;
+        case 4: case 5: case 6:
+            snprintf(buf, sizeof(buf), "%.8f", size(gen));
+            break;
+        case 7:
+            snprintf(buf, sizeof(buf), "%.*f", decimals(gen), size(gen));
+            break;
+        case 8:
+            snprintf(buf, sizeof(buf), "%d", static_cast<int>(size(gen) * 100));
+            break;
+        default:
+            snprintf(buf, sizeof(buf), "%.8f", price(gen) * 1000.0);
+            break;
+        }
+        out.emplace_back(buf);
+    }
+    return out;
+}
+
+// The same decimals laid out back to back in one buffer, as in a frame,
+// with 16 bytes of slack at the end so every one can be read in place.
+struct DecimalFrame {
+    string buffer;
+    vector<string_view> fields;
+
+    explicit DecimalFrame(const vector<string>& decimals) {
+        vector<size_t> offsets;
+        for (const auto& s : decimals) {
+            offsets.push_back(buffer.size());
+            buffer += s;
+            buffer += ',';
+        }
+        buffer.append(16, '\0');
+        for (size_t i = 0; i < decimals.size(); ++i) fields.emplace_back(buffer.data() + offsets[i], decimals[i].size());
+    }
+};
+
+template<typename Fn>
+double ns_per_call(size_t calls, Fn&& fn) {
+    auto start = chrono::high_resolution_clock::now();
+    fn();
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - start).count() /
+           static_cast<double>(calls);
+}
+
+}
+
+void benchmark_decimal_parsing() {
+    cout << "\n DECIMAL PARSE BENCHMARK (strtod vs scalar vs SIMD fixed point)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t count = 200000;
+    auto decimals = generate_decimals(count);
+    DecimalFrame frame(decimals);
+
+    // Correctness: the SIMD paths must agree bit for bit with the scalar
+    // parser, and both must agree with strtod to within the last digit.
+    size_t scalar_mismatches = 0, pair_mismatches = 0, strtod_mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const string& s = decimals[i];
+        const string& t = decimals[(i * 7919 + 1) % count];
+        int64_t scalar = 0, simd = 0, pair_a = 0, pair_b = 0, scalar_t = 0;
+        bool scalar_ok = parse_fixed_point_scalar(s.data(), s.size(), scalar);
+        bool simd_ok = parse_fixed_point(s.data(), s.size(), simd);
+        if (scalar_ok != simd_ok || scalar != simd) ++scalar_mismatches;
+        int64_t in_place = 0;
+        bool in_place_ok = parse_fixed_point(frame.fields[i].data(), frame.fields[i].size(), in_place, true);
+        if (in_place_ok != scalar_ok || in_place != scalar) ++scalar_mismatches;
+
+        bool pair_ok = parse_fixed_point_pair(s.data(), s.size(), t.data(), t.size(), pair_a, pair_b);
+        bool t_ok = parse_fixed_point_scalar(t.data(), t.size(), scalar_t);
+        if (pair_ok != (scalar_ok && t_ok) || pair_a != scalar || pair_b != scalar_t) ++pair_mismatches;
+        string_view fs = frame.fields[i], ft = frame.fields[(i * 7919 + 1) % count];
+        pair_ok = parse_fixed_point_pair(fs.data(), fs.size(), ft.data(), ft.size(), pair_a, pair_b, true);
+        if (pair_ok != (scalar_ok && t_ok) || pair_a != scalar || pair_b != scalar_t) ++pair_mismatches;
+
+        // strtod carries ~16 significant digits, so allow its rounding error.
+        double reference = strtod(s.c_str(), nullptr) * FIXED_POINT_SCALE;
+        if (fabs(reference - static_cast<double>(simd)) > 1.0 + fabs(reference) * 4e-16) ++strtod_mismatches;
+    }
+
+    const char* malformed[] = {"", "-", ".", "1.2.3", "12a", "1e5", " 1", "+1", "--1", "0x10", "12.", ".5",
+                               "-67123.45", "123456789.5", "12345678901234567", "0.123456789", "00000000.00000001"};
+    size_t edge_mismatches = 0;
+    for (const char* s : malformed) {
+        int64_t scalar = 0, simd = 0;
+        size_t len = char_traits<char>::length(s);
+        bool scalar_ok = parse_fixed_point_scalar(s, len, scalar);
+        bool simd_ok = parse_fixed_point(s, len, simd);
+        if (scalar_ok != simd_ok || (scalar_ok && scalar != simd)) {
+            ++edge_mismatches;
+            cout << "  edge case differs: \"" << s << "\"" << endl;
+        }
+    }
+
+    cout << "Checked " << count << " strings: " << scalar_mismatches << " SIMD/scalar mismatches, "
+         << pair_mismatches << " pair mismatches, " << strtod_mismatches << " disagree with strtod, "
+         << edge_mismatches << "/" << size(malformed) << " edge cases differ" << endl;
+
+    volatile int64_t sink = 0;
+    double strtod_ns = ns_per_call(count, [&]() {
+        double total = 0.0;
+        for (const auto& s : decimals) total += strtod(s.c_str(), nullptr);
+        sink = static_cast<int64_t>(total);
+    });
+    double scalar_ns = ns_per_call(count, [&]() {
+        int64_t total = 0, value;
+        for (const auto& s : decimals) total += parse_fixed_point_scalar(s.data(), s.size(), value) ? value : 0;
+        sink = total;
+    });
+    double simd_ns = ns_per_call(count, [&]() {
+        int64_t total = 0, value;
+        for (const auto& s : decimals) total += parse_fixed_point(s.data(), s.size(), value) ? value : 0;
+        sink = total;
+    });
+    double in_place_ns = ns_per_call(count, [&]() {
+        int64_t total = 0, value;
+        for (const auto& s : frame.fields) total += parse_fixed_point(s.data(), s.size(), value, true) ? value : 0;
+        sink = total;
+    });
+    double pair_ns = ns_per_call(count, [&]() {
+        int64_t total = 0, a, b;
+        for (size_t i = 0; i + 1 < count; i += 2) {
+            string_view s = frame.fields[i];
+            string_view t = frame.fields[i + 1];
+            if (parse_fixed_point_pair(s.data(), s.size(), t.data(), t.size(), a, b, true)) total += a + b;
+        }
+        sink = total;
+    });
+
+    cout << "strtod:                 " << fixed << setprecision(1) << strtod_ns << " ns/field" << endl;
+    cout << "parse_fixed_point_scalar: " << scalar_ns << " ns/field" << endl;
+#ifdef __SSE4_1__
+    cout << "parse_fixed_point (SSE):  " << simd_ns << " ns/field" << endl;
+    cout << "  in place (padded frame): " << in_place_ns << " ns/field" << endl;
+#else
+    cout << "parse_fixed_point:        " << simd_ns << " ns/field (no SSE4.1, scalar)" << endl;
+    (void)in_place_ns;
+#endif
+#ifdef __AVX2__
+    cout << "parse_fixed_point_pair (AVX2, in place): " << pair_ns << " ns/field" << endl;
+#else
+    cout << "parse_fixed_point_pair:   " << pair_ns << " ns/field (no AVX2, two single parses)" << endl;
+#endif
+    cout << "Speedup vs strtod: " << setprecision(2) << strtod_ns / min(in_place_ns, pair_ns) << "x" << endl;
+    cout << string(60, '=') << endl;
+}
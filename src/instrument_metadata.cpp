@@ -0,0 +1,124 @@
+#include "instrument_metadata.hpp"
+#include "sampled_history.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+using json = nlohmann::json;
+
+int64_t unix_seconds() {
+    return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t parse_expiry(const string& text) {
+    tm t{};
+    int fields = sscanf(text.c_str(), "%d-%d-%dT%d:%d:%d", &t.tm_year, &t.tm_mon, &t.tm_mday,
+                        &t.tm_hour, &t.tm_min, &t.tm_sec);
+    if (fields == 3) {
+        t.tm_hour = 8;
+    } else if (fields != 6) {
+        throw invalid_argument("bad expiry: " + text);
+    }
+    t.tm_year -= 1900;
+    t.tm_mon -= 1;
+    return static_cast<int64_t>(timegm(&t));
+}
+
+double InstrumentMetadata::years_to_expiry(int64_t now_s) const {
+    if (!dated()) return 0.0;
+    return max(0.0, (expiry_s - now_s) / SECONDS_PER_YEAR);
+}
+
+double InstrumentMetadata::horizon_years(int64_t now_s) const {
+    if (dated()) return years_to_expiry(now_s);
+    return funding_interval_hours * 3600.0 / SECONDS_PER_YEAR;
+}
+
+const FeeTier& InstrumentMetadata::fee_tier(double volume_usd) const {
+    size_t tier = 0;
+    while (tier + 1 < fee_tiers.size() && fee_tiers[tier + 1].min_volume_usd <= volume_usd) ++tier;
+    return fee_tiers[tier];
+}
+
+InstrumentMetadataStore::InstrumentMetadataStore(const InstrumentRegistry& registry) {
+    entries.resize(registry.size());
+    for (const auto& info : registry.all()) {
+        InstrumentMetadata& entry = entries[info.id];
+        entry.spec = info.spec;
+        // Every futures row in the compiled table is a linear perpetual.
+        if (info.market == MarketType::Futures) entry.funding_interval_hours = 8.0;
+    }
+}
+
+namespace {
+
+InstrumentId resolve(const InstrumentRegistry& registry, const string& exchange, const string& market,
+                     const string& symbol) {
+    for (const auto& info : registry.all()) {
+        if (exchange == exchange_name(info.exchange) && market == market_name(info.market) && symbol == info.symbol) {
+            return info.id;
+        }
+    }
+    return INVALID_INSTRUMENT;
+}
+
+}
+
+size_t InstrumentMetadataStore::load(const string& path, InstrumentRegistry& registry) {
+    ifstream file(path);
+    if (!file) {
+        cout << "[METADATA] " << path << " not found, using built-in contract terms" << endl;
+        return 0;
+    }
+    json document = json::parse(file);
+
+    size_t applied = 0;
+    for (const json& row : document.at("instruments")) {
+        string exchange = row.at("exchange").get<string>();
+        string market = row.at("market").get<string>();
+        string symbol = row.at("symbol").get<string>();
+        InstrumentId id = resolve(registry, exchange, market, symbol);
+        if (id == INVALID_INSTRUMENT) {
+            cout << "[METADATA] Skipping unknown instrument " << exchange << " " << market << " " << symbol << endl;
+            continue;
+        }
+
+        InstrumentMetadata& entry = entries[id];
+        if (row.contains("tick_size") || row.contains("lot_size")) {
+            string tick = row.value("tick_size", string());
+            string lot = row.value("lot_size", string());
+            InstrumentSpec spec = entry.spec;
+            if (!tick.empty()) spec.tick_size = Price::parse(tick.data(), tick.size());
+            if (!lot.empty()) spec.lot_size = Qty::parse(lot.data(), lot.size());
+            if (spec.tick_size.raw <= 0 || spec.lot_size.raw <= 0) {
+                throw invalid_argument("bad tick or lot size for " + exchange + " " + symbol);
+            }
+            entry.spec = spec;
+            registry.set_spec(id, spec);
+        }
+        entry.contract_multiplier = row.value("contract_multiplier", entry.contract_multiplier);
+        if (row.contains("expiry")) {
+            entry.expiry_s = row["expiry"].is_null() ? 0 : parse_expiry(row["expiry"].get<string>());
+        }
+        entry.funding_interval_hours = row.value("funding_interval_hours", entry.funding_interval_hours);
+        if (row.contains("fee_tiers")) {
+            entry.fee_tiers.clear();
+            for (const json& tier : row["fee_tiers"]) {
+                entry.fee_tiers.push_back({tier.value("min_volume_usd", 0.0), tier.at("maker_bps").get<double>() / 10000.0,
+                                           tier.at("taker_bps").get<double>() / 10000.0});
+            }
+            if (entry.fee_tiers.empty()) entry.fee_tiers.push_back(FeeTier{});
+            sort(entry.fee_tiers.begin(), entry.fee_tiers.end(),
+                 [](const FeeTier& a, const FeeTier& b) { return a.min_volume_usd < b.min_volume_usd; });
+        }
+        applied++;
+    }
+    cout << "[METADATA] Loaded contract terms for " << applied << " instruments from " << path << endl;
+    return applied;
+}
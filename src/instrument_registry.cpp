@@ -0,0 +1,101 @@
+#include "instrument_registry.hpp"
+#include <new>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const char* const EXCHANGE_NAMES[EXCHANGE_COUNT] = {"Binance", "Bybit", "OKX"};
+const char* const ASSET_NAMES[ASSET_COUNT] = {"Bitcoin", "Ethereum"};
+const char* const ASSET_CODES[ASSET_COUNT] = {"BTC", "ETH"};
+const char* const MARKET_NAMES[MARKET_TYPE_COUNT] = {"Spot", "Futures"};
+
+}
+
+const char* exchange_name(Exchange exchange) { return EXCHANGE_NAMES[static_cast<size_t>(exchange)]; }
+const char* asset_name(Asset asset) { return ASSET_NAMES[static_cast<size_t>(asset)]; }
+const char* asset_code(Asset asset) { return ASSET_CODES[static_cast<size_t>(asset)]; }
+const char* market_name(MarketType market) { return MARKET_NAMES[static_cast<size_t>(market)]; }
+
+const vector<InstrumentDefinition>& default_instrument_table() {
+    static const vector<InstrumentDefinition> table = {
+        {Exchange::Binance, Asset::Bitcoin,  MarketType::Spot,    "BTCUSDT",       "0.01", "0.00001"},
+        {Exchange::Binance, Asset::Bitcoin,  MarketType::Futures, "BTCUSDT",       "0.1",  "0.001"},
+        {Exchange::Bybit,   Asset::Bitcoin,  MarketType::Spot,    "BTCUSDT",       "0.01", "0.000001"},
+        {Exchange::Bybit,   Asset::Bitcoin,  MarketType::Futures, "BTCUSDT",       "0.1",  "0.001"},
+        {Exchange::OKX,     Asset::Bitcoin,  MarketType::Spot,    "BTC-USDT",      "0.1",  "0.00000001"},
+        {Exchange::OKX,     Asset::Bitcoin,  MarketType::Futures, "BTC-USDT-SWAP", "0.1",  "0.01"},
+        {Exchange::Binance, Asset::Ethereum, MarketType::Spot,    "ETHUSDT",       "0.01", "0.0001"},
+        {Exchange::Binance, Asset::Ethereum, MarketType::Futures, "ETHUSDT",       "0.01", "0.001"},
+        {Exchange::Bybit,   Asset::Ethereum, MarketType::Spot,    "ETHUSDT",       "0.01", "0.00001"},
+        {Exchange::Bybit,   Asset::Ethereum, MarketType::Futures, "ETHUSDT",       "0.01", "0.01"},
+        {Exchange::OKX,     Asset::Ethereum, MarketType::Spot,    "ETH-USDT",      "0.01", "0.000001"},
+        {Exchange::OKX,     Asset::Ethereum, MarketType::Futures, "ETH-USDT-SWAP", "0.01", "0.01"},
+    };
+    return table;
+}
+
+string InstrumentInfo::market_label() const {
+    return string(asset_name(asset)) + " " + market_name(market);
+}
+
+string InstrumentInfo::full_name() const {
+    return string(exchange_name(exchange)) + " " + market_label();
+}
+
+InstrumentRegistry::InstrumentRegistry(const vector<InstrumentDefinition>& table) {
+    if (table.size() >= INVALID_INSTRUMENT) {
+        throw invalid_argument("instrument table too large");
+    }
+    index.fill(INVALID_INSTRUMENT);
+    instruments.reserve(table.size());
+
+    for (const auto& def : table) {
+        size_t s = slot(def.exchange, def.asset, def.market);
+        if (index[s] != INVALID_INSTRUMENT) {
+            throw invalid_argument(string("duplicate instrument: ") + exchange_name(def.exchange) + " " + def.symbol);
+        }
+        InstrumentId id = static_cast<InstrumentId>(instruments.size());
+        index[s] = id;
+        instruments.push_back({id, def.exchange, def.asset, def.market, def.symbol,
+                               InstrumentSpec::make(def.tick_size, def.lot_size)});
+    }
+
+    // Books hold atomics and are never moved, so they are built in place in
+    // a single allocation rather than through a vector.
+    books = static_cast<FastOrderbook*>(::operator new(sizeof(FastOrderbook) * instruments.size(),
+                                                       align_val_t(alignof(FastOrderbook))));
+    for (const auto& instrument : instruments) {
+        new (&books[instrument.id]) FastOrderbook(instrument.spec);
+    }
+    bbos = make_unique<BboSlot[]>(instruments.size());
+    fundings = make_unique<FundingSlot[]>(instruments.size());
+}
+
+InstrumentRegistry::~InstrumentRegistry() {
+    for (size_t i = 0; i < instruments.size(); ++i) {
+        books[i].~FastOrderbook();
+    }
+    ::operator delete(books, align_val_t(alignof(FastOrderbook)));
+}
+
+void InstrumentRegistry::set_spec(InstrumentId id, const InstrumentSpec& spec) {
+    instruments[id].spec = spec;
+    books[id].set_spec(spec);
+}
+
+InstrumentId InstrumentRegistry::find(const string& exchange, const string& instrument) const {
+    for (size_t e = 0; e < EXCHANGE_COUNT; ++e) {
+        if (exchange != EXCHANGE_NAMES[e]) continue;
+        for (size_t a = 0; a < ASSET_COUNT; ++a) {
+            if (instrument == ASSET_NAMES[a]) {
+                return id(static_cast<Exchange>(e), static_cast<Asset>(a), MarketType::Spot);
+            }
+            if (instrument == string(ASSET_NAMES[a]) + "_Futures") {
+                return id(static_cast<Exchange>(e), static_cast<Asset>(a), MarketType::Futures);
+            }
+        }
+    }
+    return INVALID_INSTRUMENT;
+}
@@ -0,0 +1,101 @@
+#include "leg_arbiter.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+struct LegArrival {
+    int64_t ns;
+    int64_t id;
+    int leg;
+};
+
+double percentile_us(vector<int64_t> values, double p) {
+    if (values.empty()) return 0.0;
+    sort(values.begin(), values.end());
+    return values[min(values.size() - 1, static_cast<size_t>(values.size() * p))] / 1000.0;
+}
+
+}
+
+// Two simulated legs carry the same sequence with independent latency and
+// occasional stalls (TCP keeps each leg in order, so a stall delays
+// everything queued behind it). Merging should apply every update exactly
+// once, in order, at the earlier of the two arrivals.
+void LegArbiter::benchmark_ab_merge() {
+    cout << "\n A/B FEED MERGE (first arrival wins by update ID)" << endl;
+    cout << string(60, '=') << endl;
+
+    const size_t updates = 200000;
+    const int64_t interval_ns = 100000;
+    mt19937_64 gen(17);
+    lognormal_distribution<double> base_latency(log(600000.0), 0.35);
+    bernoulli_distribution stall(0.002);
+    exponential_distribution<double> stall_ns(1.0 / 3e6);
+
+    vector<LegArrival> arrivals;
+    arrivals.reserve(updates * LEGS);
+    vector<int64_t> leg_latency[LEGS];
+    for (int leg = 0; leg < LEGS; ++leg) {
+        int64_t previous = 0;
+        int64_t skew = leg == 0 ? 0 : 40000;  // leg B sits on a slightly longer path
+        for (size_t i = 0; i < updates; ++i) {
+            int64_t sent = static_cast<int64_t>(i) * interval_ns;
+            int64_t latency = static_cast<int64_t>(base_latency(gen)) + skew;
+            if (stall(gen)) latency += static_cast<int64_t>(stall_ns(gen));
+            int64_t arrival = max(previous, sent + latency);
+            previous = arrival;
+            arrivals.push_back({arrival, static_cast<int64_t>(i) + 1, leg});
+            leg_latency[leg].push_back(arrival - sent);
+        }
+    }
+    // Stable, so a stalled leg's burst of equal timestamps keeps its order.
+    stable_sort(arrivals.begin(), arrivals.end(), [](const LegArrival& a, const LegArrival& b) { return a.ns < b.ns; });
+
+    LegArbiter arbiter;
+    vector<int64_t> merged_latency;
+    merged_latency.reserve(updates);
+    int64_t last_applied = 0;
+    size_t out_of_order = 0;
+
+    auto start = chrono::high_resolution_clock::now();
+    for (const auto& arrival : arrivals) {
+        if (arbiter.admit(arrival.leg, arrival.id, false, arrival.ns) == Verdict::Apply) {
+            out_of_order += arrival.id != last_applied + 1;
+            last_applied = arrival.id;
+            merged_latency.push_back(arrival.ns - (arrival.id - 1) * interval_ns);
+        }
+    }
+    double admit_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::high_resolution_clock::now() - start).count() / double(arrivals.size());
+
+    const char* names[LEGS] = {"leg A only", "leg B only"};
+    for (int leg = 0; leg < LEGS; ++leg) {
+        cout << left << setw(14) << names[leg] << right << " p50 " << fixed << setprecision(1)
+             << setw(7) << percentile_us(leg_latency[leg], 0.50) << " us  p99 " << setw(8)
+             << percentile_us(leg_latency[leg], 0.99) << " us  p99.9 " << setw(8)
+             << percentile_us(leg_latency[leg], 0.999) << " us" << endl;
+    }
+    cout << left << setw(14) << "A/B merged" << right << " p50 " << fixed << setprecision(1)
+         << setw(7) << percentile_us(merged_latency, 0.50) << " us  p99 " << setw(8)
+         << percentile_us(merged_latency, 0.99) << " us  p99.9 " << setw(8)
+         << percentile_us(merged_latency, 0.999) << " us" << endl;
+
+    uint64_t total = arbiter.wins[0] + arbiter.wins[1];
+    cout << "Wins A " << setprecision(1) << 100.0 * arbiter.wins[0] / total << "% / B "
+         << 100.0 * arbiter.wins[1] / total << "%, duplicates dropped " << arbiter.duplicates.load() << endl;
+    for (int leg = 0; leg < LEGS; ++leg) {
+        double lead = arbiter.lead_samples[leg] ? arbiter.lead_ns[leg] / 1e3 / arbiter.lead_samples[leg] : 0.0;
+        cout << "Leg " << (leg == 0 ? "A" : "B") << " mean lead when winning: " << setprecision(1) << lead << " us" << endl;
+    }
+    cout << "Applied " << merged_latency.size() << "/" << updates << " updates, " << out_of_order
+         << " out of order, admit() " << setprecision(1) << admit_ns << " ns/arrival" << endl;
+    cout << string(60, '=') << endl;
+}
@@ -1,7 +1,7 @@
-#include "binance_ws.hpp"
-#include "binance_futures_ws.hpp"
-#include "bybit_ws.hpp"
-#include "okx_ws.hpp"
+#include "feed_reactor.hpp"
+#include "leg_arbiter.hpp"
+#include "book_checksum.hpp"
+#include "book_pipeline.hpp"
 #include "book_storage.hpp"
 #include "synthetic_engine.hpp"
 #include "risk_manager.hpp"
@@ -9,16 +9,17 @@
 #include "connection_pool.hpp"
 #include "multi_leg_arbitrage.hpp"
 #include "simd_optimizer.hpp"
-#include "eth_binance_ws.hpp"
-#include "eth_bybit_ws.hpp"
-#include "eth_okx_ws.hpp"
+#include "fast_json_parser.hpp"
 #include "real_volatility_arbitrage.hpp"
 #include "real_cross_asset_arbitrage.hpp"
+#include "analysis_loop.hpp"
+#include "basis_scanner.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <csignal>
 #include <iomanip>
+#include <cstdlib>
 
 using namespace std;
 
@@ -28,81 +29,41 @@ void signal_handler(int /* sig */) {
     running = false;
 }
 
-void update_real_analyzers(RealVolatilityArbitrage& real_vol_analyzer, 
-                          RealCrossAssetArbitrage& real_cross_analyzer,
-                          MultiLegArbitrageEngine& multi_leg_engine) {
-    lock_guard<mutex> lock(book_mutex);
-    
-    if (!spot_bids.empty() && !spot_asks.empty() &&
-        !futures_bids.empty() && !futures_asks.empty()) {
-        
-        double binance_btc_spot = (spot_bids.rbegin()->first + spot_asks.begin()->first) / 2.0;
-        double binance_btc_futures = (futures_bids.rbegin()->first + futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("Binance", "Bitcoin", binance_btc_spot, binance_btc_futures);
-        real_cross_analyzer.update_asset_price("Binance", "Bitcoin", binance_btc_spot);
-        multi_leg_engine.update_market_data("Binance", "Bitcoin", binance_btc_spot, binance_btc_futures); 
-    }
-    
-    if (!eth_spot_bids.empty() && !eth_spot_asks.empty() &&
-        !eth_futures_bids.empty() && !eth_futures_asks.empty()) {
-        
-        double binance_eth_spot = (eth_spot_bids.rbegin()->first + eth_spot_asks.begin()->first) / 2.0;
-        double binance_eth_futures = (eth_futures_bids.rbegin()->first + eth_futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("Binance", "Ethereum", binance_eth_spot, binance_eth_futures);
-        real_cross_analyzer.update_asset_price("Binance", "Ethereum", binance_eth_spot);
-        multi_leg_engine.update_market_data("Binance", "Ethereum", binance_eth_spot, binance_eth_futures); 
-    }
-    
-  
-    if (!bybit_spot_bids.empty() && !bybit_spot_asks.empty() &&
-        !bybit_futures_bids.empty() && !bybit_futures_asks.empty()) {
-        
-        double bybit_btc_spot = (bybit_spot_bids.rbegin()->first + bybit_spot_asks.begin()->first) / 2.0;
-        double bybit_btc_futures = (bybit_futures_bids.rbegin()->first + bybit_futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("Bybit", "Bitcoin", bybit_btc_spot, bybit_btc_futures);
-        real_cross_analyzer.update_asset_price("Bybit", "Bitcoin", bybit_btc_spot);
-        multi_leg_engine.update_market_data("Bybit", "Bitcoin", bybit_btc_spot, bybit_btc_futures);
-    }
-    
-    if (!eth_bybit_spot_bids.empty() && !eth_bybit_spot_asks.empty() &&
-        !eth_bybit_futures_bids.empty() && !eth_bybit_futures_asks.empty()) {
-        
-        double bybit_eth_spot = (eth_bybit_spot_bids.rbegin()->first + eth_bybit_spot_asks.begin()->first) / 2.0;
-        double bybit_eth_futures = (eth_bybit_futures_bids.rbegin()->first + eth_bybit_futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("Bybit", "Ethereum", bybit_eth_spot, bybit_eth_futures);
-        real_cross_analyzer.update_asset_price("Bybit", "Ethereum", bybit_eth_spot);
-        multi_leg_engine.update_market_data("Bybit", "Ethereum", bybit_eth_spot, bybit_eth_futures); 
-    }
-    
-    
-    if (!okx_spot_bids.empty() && !okx_spot_asks.empty() &&
-        !okx_futures_bids.empty() && !okx_futures_asks.empty()) {
-        
-        double okx_btc_spot = (okx_spot_bids.rbegin()->first + okx_spot_asks.begin()->first) / 2.0;
-        double okx_btc_futures = (okx_futures_bids.rbegin()->first + okx_futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("OKX", "Bitcoin", okx_btc_spot, okx_btc_futures);
-        real_cross_analyzer.update_asset_price("OKX", "Bitcoin", okx_btc_spot);
-        multi_leg_engine.update_market_data("OKX", "Bitcoin", okx_btc_spot, okx_btc_futures); 
-    }
-    
-    if (!eth_okx_spot_bids.empty() && !eth_okx_spot_asks.empty() &&
-        !eth_okx_futures_bids.empty() && !eth_okx_futures_asks.empty()) {
-        
-        double okx_eth_spot = (eth_okx_spot_bids.rbegin()->first + eth_okx_spot_asks.begin()->first) / 2.0;
-        double okx_eth_futures = (eth_okx_futures_bids.rbegin()->first + eth_okx_futures_asks.begin()->first) / 2.0;
-        
-        real_vol_analyzer.update_market_data("OKX", "Ethereum", okx_eth_spot, okx_eth_futures);
-        real_cross_analyzer.update_asset_price("OKX", "Ethereum", okx_eth_spot);
-        multi_leg_engine.update_market_data("OKX", "Ethereum", okx_eth_spot, okx_eth_futures); 
-    }
+// Console reports run on their own timer, never on the analysis path.
+constexpr int REPORT_INTERVAL_MS = 500;
+
+// Contract terms; ARBIT_INSTRUMENTS overrides the path.
+constexpr const char* INSTRUMENT_METADATA_PATH = "config/instruments.json";
+
+void print_detection_latency(const AnalysisLoop& analysis_loop, const SyntheticEngine& synthetic_engine) {
+    analysis_loop.print_stats();
+    synthetic_engine.detection_latency.print("Book change -> repriced");
+}
+
+void run_benchmarks() {
+    benchmark_decimal_parsing();
+    FastOrderbook::benchmark_against_map();
+    FastOrderbook::benchmark_reader_contention();
+    FastOrderbook::benchmark_depth_queries();
+    FastJsonParser::benchmark_against_dom();
+    benchmark_book_checksum();
+    FeedReactor::benchmark_reactor_layouts();
+    LegArbiter::benchmark_ab_merge();
+    BboSlot::benchmark_bbo_sources();
+    BookPipeline::benchmark_pipeline();
+    MarketEventBus::benchmark_event_bus();
+    AnalysisLoop::benchmark_detection_latency();
+    SyntheticEngine::benchmark_incremental_repricing();
+    BasisScanner::benchmark_basis_scan();
+    SIMDOptimizer::benchmark_simd_performance();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        run_benchmarks();
+        return 0;
+    }
+    
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
     
@@ -110,6 +71,13 @@ int main() {
     
     PerformanceMonitor::start_monitoring();
     
+    try {
+        const char* metadata_path = getenv("ARBIT_INSTRUMENTS");
+        instrument_metadata.load(metadata_path ? metadata_path : INSTRUMENT_METADATA_PATH, instrument_registry);
+    } catch (const exception& e) {
+        cout << "[ERROR] Failed to load instrument metadata: " << e.what() << endl;
+    }
+    
     MultiLegArbitrageEngine* multi_leg_engine = nullptr;
     try {
         multi_leg_engine = new MultiLegArbitrageEngine();
@@ -125,7 +93,14 @@ int main() {
         cout << "[ERROR] Failed to initialize SIMD optimizer: " << e.what() << endl;
     }
     
-    ConnectionPool connection_pool(6);
+    FeedConfig feed_config;
+    feed_config.reactor_shards = 1;
+    feed_config.warm_standby = true;
+    feed_config.ab_arbitration = false;
+    feed_config.bbo_channels = true;
+    feed_config.funding_channels = true;
+    feed_config.book_pipeline = true;
+    ConnectionPool connection_pool(feed_config.reactor_shards);
     
     RiskConfig risk_config;
     risk_config.initial_capital = 10000.0;
@@ -142,141 +117,108 @@ int main() {
     
     RealVolatilityArbitrage real_vol_analyzer;
     RealCrossAssetArbitrage real_cross_analyzer;
+    BasisScanner basis_scanner;
     cout << "REAL advanced arbitrage engines initialized - NO SIMULATION DATA." << endl;
     
-    connection_pool.add_connection("Binance_Spot", "wss://stream.binance.com:9443/ws/btcusdt@depth",
-        [](string data) {
-            PERF_TIMER("parse_binance_spot");
-            (void)data;
-        });
-    
-    connection_pool.add_connection("Binance_Futures", "wss://fstream.binance.com/ws/btcusdt@depth",
-        [](string data) {
-            PERF_TIMER("parse_binance_futures");
-            (void)data;
-        });
-    
+    FeedReactor feed_reactor(connection_pool, feed_config);
+    feed_reactor.start();
     connection_pool.start_all_connections();
     
-    thread binance_spot_thread([]() { try { start_binance_ws(); } catch (const exception& e) { cout << "[ERROR] Binance spot thread error: " << e.what() << endl; }});
-    thread binance_futures_thread([]() { try { start_binance_futures_ws(); } catch (const exception& e) { cout << "[ERROR] Binance futures thread error: " << e.what() << endl; }});
-    thread bybit_spot_thread([]() { try { start_bybit_spot_ws(); } catch (const exception& e) { cout << "[ERROR] Bybit spot thread error: " << e.what() << endl; }});
-    thread bybit_futures_thread([]() { try { start_bybit_futures_ws(); } catch (const exception& e) { cout << "[ERROR] Bybit futures thread error: " << e.what() << endl; }});
-    thread okx_spot_thread([]() { try { start_okx_spot_ws(); } catch (const exception& e) { cout << "[ERROR] OKX spot thread error: " << e.what() << endl; }});
-    thread okx_futures_thread([]() { try { start_okx_futures_ws(); } catch (const exception& e) { cout << "[ERROR] OKX futures thread error: " << e.what() << endl; }});
-    thread eth_binance_spot_thread([]() { try { start_eth_binance_spot_ws(); } catch (const exception& e) { cout << "[ERROR] ETH Binance spot thread error: " << e.what() << endl; }});
-    thread eth_binance_futures_thread([]() { try { start_eth_binance_futures_ws(); } catch (const exception& e) { cout << "[ERROR] ETH Binance futures thread error: " << e.what() << endl; }});
-    thread eth_bybit_spot_thread([]() { try { start_eth_bybit_spot_ws(); } catch (const exception& e) { cout << "[ERROR] ETH Bybit spot thread error: " << e.what() << endl; }});
-    thread eth_bybit_futures_thread([]() { try { start_eth_bybit_futures_ws(); } catch (const exception& e) { cout << "[ERROR] ETH Bybit futures thread error: " << e.what() << endl; }});
-    thread eth_okx_spot_thread([]() { try { start_eth_okx_spot_ws(); } catch (const exception& e) { cout << "[ERROR] ETH OKX spot thread error: " << e.what() << endl; }});
-    thread eth_okx_futures_thread([]() { try { start_eth_okx_futures_ws(); } catch (const exception& e) { cout << "[ERROR] ETH OKX futures thread error: " << e.what() << endl; }});
-    
     this_thread::sleep_for(chrono::seconds(5));
     
     synthetic_engine.start();
+    AnalysisLoop analysis_loop({real_vol_analyzer, real_cross_analyzer, multi_leg_engine, risk_manager, &basis_scanner});
+    analysis_loop.start();
     cout << "Starting HIGH-PERFORMANCE analysis with REAL BONUS FEATURES..." << endl;
     
-    int cycle_count = 0;
+    int report_count = 0;
     auto last_performance_report = chrono::high_resolution_clock::now();
     
+    // Analysis runs on market events; from here on this thread only reports.
+    lower_thread_priority();
     while (running) {
         try {
-            PERF_TIMER("main_analysis_cycle");
-            cycle_count++;
+            this_thread::sleep_for(chrono::milliseconds(REPORT_INTERVAL_MS));
+            PERF_TIMER("report_cycle");
+            report_count++;
             
-            if (cycle_count % 10 == 0) {
-                {
-                    PERF_TIMER("arbitrage_analysis");
-                    lock_guard<mutex> lock(book_mutex);
-                    print_all_books();
-                }
+            {
+                PERF_TIMER("arbitrage_analysis");
+                print_all_books();
+            }
+            
+            {
+                PERF_TIMER("synthetic_analysis");
+                synthetic_engine.print_mispricing_opportunities();
+            }
+            
+            try {
+                cout << "\n" << string(80, '*') << endl;
+                cout << "*** ADVANCED TRADING STRATEGIES ***" << endl;
+                cout << string(80, '*') << endl;
                 
                 if (multi_leg_engine != nullptr) {
-                    update_real_analyzers(real_vol_analyzer, real_cross_analyzer, *multi_leg_engine); 
-                } else {
-                    lock_guard<mutex> lock(book_mutex);
-                    if (!spot_bids.empty() && !futures_bids.empty()) {
-                        double binance_btc_spot = (spot_bids.rbegin()->first + spot_asks.begin()->first) / 2.0;
-                        double binance_btc_futures = (futures_bids.rbegin()->first + futures_asks.begin()->first) / 2.0;
-                        real_vol_analyzer.update_market_data("Binance", "Bitcoin", binance_btc_spot, binance_btc_futures);
-                        real_cross_analyzer.update_asset_price("Binance", "Bitcoin", binance_btc_spot);
-                    }
+                    multi_leg_engine->print_multi_leg_opportunities();
                 }
+                basis_scanner.print_basis_opportunities();
                 
-                {
-                    PERF_TIMER("synthetic_analysis");
-                    synthetic_engine.print_mispricing_opportunities();
-                }
-                
-                try {
-                    cout << "\n" << string(80, '*') << endl;
-                    cout << "*** ADVANCED TRADING STRATEGIES ***" << endl;
-                    cout << string(80, '*') << endl;
-                    
-                    if (multi_leg_engine != nullptr) {
-                        multi_leg_engine->print_multi_leg_opportunities();
-                    }
-                    
-                    if (cycle_count % 20 == 0) {
-                        lock_guard<mutex> lock(book_mutex);
-                        if (!spot_bids.empty() && !spot_asks.empty()) {
-                            vector<float> real_bids, real_asks;
-                            auto bid_it = spot_bids.rbegin();
-                            auto ask_it = spot_asks.begin();
-                            
-                            for (int i = 0; i < 8 && bid_it != spot_bids.rend() && ask_it != spot_asks.end(); ++i) {
-                                real_bids.push_back(static_cast<float>(bid_it->first));
-                                real_asks.push_back(static_cast<float>(ask_it->first));
-                                ++bid_it; ++ask_it;
+                if (report_count % 2 == 0) {
+                    BookSnapshot binance_spot_snap = instrument_registry.book(Exchange::Binance, Asset::Bitcoin, MarketType::Spot).snapshot();
+                    if (binance_spot_snap.has_quotes()) {
+                        vector<float> real_bids, real_asks;
+                        size_t depth = min(binance_spot_snap.bid_depth, binance_spot_snap.ask_depth);
+                        
+                        for (size_t i = 0; i < depth; ++i) {
+                            real_bids.push_back(static_cast<float>(binance_spot_snap.bids[i].price.to_double()));
+                            real_asks.push_back(static_cast<float>(binance_spot_snap.asks[i].price.to_double()));
+                        }
+                        
+                        if (real_bids.size() >= 4) {
+                            auto simd_result = SIMDOptimizer::calculate_arbitrage_batch_simd(real_bids, real_asks, 0.01f);
+                            cout << "\n*** SIMD REAL-TIME ANALYSIS ***" << endl;
+                            cout << string(60, '=') << endl;
+                            cout << "[SIMD] Real Market Data: Processed " << real_bids.size() << " price pairs" << endl;
+                            cout << "[SIMD] Micro-opportunities Found: " << simd_result.valid_count << endl;
+                            if (simd_result.valid_count > 0) {
+                                cout << "[SIMD] Best Micro-profit: $" << fixed << setprecision(4) << simd_result.profits[0] << " ("
+                                     << setprecision(6) << simd_result.roi_percentages[0] << "%)" << endl;
                             }
                             
-                            if (real_bids.size() >= 4) {
-                                auto simd_result = SIMDOptimizer::calculate_arbitrage_batch_simd(real_bids, real_asks, 0.01f);
-                                cout << "\n*** SIMD REAL-TIME ANALYSIS ***" << endl;
-                                cout << string(60, '=') << endl;
-                                cout << "[SIMD] Real Market Data: Processed " << real_bids.size() << " price pairs" << endl;
-                                cout << "[SIMD] Micro-opportunities Found: " << simd_result.valid_count << endl;
-                                if (simd_result.valid_count > 0) {
-                                    cout << "[SIMD] Best Micro-profit: $" << fixed << setprecision(4) << simd_result.profits[0] << " ("
-                                         << setprecision(6) << simd_result.roi_percentages[0] << "%)" << endl;
-                                }
-                                
-                                vector<float> spreads;
-                                SIMDOptimizer::calculate_spreads_simd(real_bids, real_asks, spreads);
-                                if (!spreads.empty()) {
-                                    cout << "[SIMD] Real-time Spread Analysis: Avg $"
-                                         << fixed << setprecision(4)
-                                         << SIMDOptimizer::calculate_mean_simd(spreads) << endl;
-                                }
-                                cout << string(60, '=') << endl;
+                            vector<float> spreads;
+                            SIMDOptimizer::calculate_spreads_simd(real_bids, real_asks, spreads);
+                            if (!spreads.empty()) {
+                                cout << "[SIMD] Real-time Spread Analysis: Avg $"
+                                     << fixed << setprecision(4)
+                                     << SIMDOptimizer::calculate_mean_simd(spreads) << endl;
                             }
+                            cout << string(60, '=') << endl;
                         }
                     }
-                    cout << string(80, '*') << endl;
-                } catch (const exception& e) {
-                    cout << "[ERROR] Advanced strategies error: " << e.what() << endl;
-                }
-                
-                try {
-                    real_vol_analyzer.print_real_volatility_analysis();
-                    real_cross_analyzer.print_real_cross_asset_analysis();
-                } catch (const exception& e) {
-                    cout << "[ERROR] REAL advanced arbitrage strategies error: " << e.what() << endl;
-                }
-                
-                auto now = chrono::high_resolution_clock::now();
-                if (chrono::duration_cast<chrono::seconds>(now - last_performance_report).count() >= 30) {
-                    PerformanceMonitor::print_performance_report();
-                    connection_pool.print_connection_stats();
-                    last_performance_report = now;
                 }
+                cout << string(80, '*') << endl;
+            } catch (const exception& e) {
+                cout << "[ERROR] Advanced strategies error: " << e.what() << endl;
             }
             
-            if (cycle_count % 50 == 0) {
-                risk_manager.print_risk_summary();
+            try {
+                real_vol_analyzer.print_real_volatility_analysis();
+                real_cross_analyzer.print_real_cross_asset_analysis();
+            } catch (const exception& e) {
+                cout << "[ERROR] REAL advanced arbitrage strategies error: " << e.what() << endl;
             }
             
-            this_thread::sleep_for(chrono::milliseconds(50));
+            auto now = chrono::high_resolution_clock::now();
+            if (chrono::duration_cast<chrono::seconds>(now - last_performance_report).count() >= 30) {
+                PerformanceMonitor::print_performance_report();
+                connection_pool.print_connection_stats();
+                feed_reactor.print_feed_health();
+                print_detection_latency(analysis_loop, synthetic_engine);
+                last_performance_report = now;
+            }
+            
+            if (report_count % 5 == 0) {
+                risk_manager.print_risk_summary();
+            }
         } catch (const exception& e) {
             cout << "[ERROR] Main loop error: " << e.what() << endl;
             this_thread::sleep_for(chrono::milliseconds(100));
@@ -289,6 +231,8 @@ int main() {
         cout << "\n[SHUTDOWN] FINAL PERFORMANCE REPORT:" << endl;
         PerformanceMonitor::print_performance_report();
         connection_pool.print_connection_stats();
+        feed_reactor.print_feed_health();
+        print_detection_latency(analysis_loop, synthetic_engine);
         
         if (multi_leg_engine != nullptr) {
             cout << "\n[SHUTDOWN] FINAL MULTI-LEG ANALYSIS:" << endl;
@@ -306,7 +250,9 @@ int main() {
         cout << "[ERROR] Shutdown report error: " << e.what() << endl;
     }
     
+    analysis_loop.stop();
     synthetic_engine.stop();
+    feed_reactor.stop();
     connection_pool.stop_all_connections();
     PerformanceMonitor::stop_monitoring();
     
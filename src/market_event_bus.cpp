@@ -0,0 +1,182 @@
+#include "market_event_bus.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+MarketEventBus market_event_bus;
+
+namespace {
+
+int64_t steady_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+MarketEventBus::MarketEventBus() : slots(make_unique<SeqLock<MarketEvent>[]>(CAPACITY)) {
+    // Zeroed slots would read as sequence 0; mark them unpublished.
+    for (size_t i = 0; i < CAPACITY; ++i) slots[i].store(MarketEvent{});
+}
+
+void MarketEventBus::publish(MarketEventType type, InstrumentId instrument, BboSource source, const PriceLevel& bid,
+                             const PriceLevel& ask, int64_t book_sequence) {
+    MarketEvent event;
+    event.sequence = claimed.fetch_add(1, memory_order_relaxed);
+    event.type = type;
+    event.source = source;
+    event.instrument = instrument;
+    event.bid = bid;
+    event.ask = ask;
+    event.book_sequence = book_sequence;
+    event.publish_ns = steady_ns();
+    slots[event.sequence & (CAPACITY - 1)].store(event);
+
+    // Pairs with the fence in MarketEventCursor::wait.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (waiters.load(memory_order_relaxed) > 0) {
+        lock_guard<mutex> lock(wait_mutex);
+        wait_cv.notify_all();
+    }
+}
+
+bool MarketEventCursor::poll(MarketEvent& event) {
+    for (;;) {
+        event = bus->slots[next & (MarketEventBus::CAPACITY - 1)].load();
+        if (event.sequence < next) return false;
+        if (event.sequence == next) {
+            ++next;
+            return true;
+        }
+        // Lapped: the slot already holds a later round. Resume half a ring
+        // behind the producers, which is certain to be written by now.
+        int64_t resume = max(next + 1, bus->published() - static_cast<int64_t>(MarketEventBus::CAPACITY / 2));
+        overruns += static_cast<uint64_t>(resume - next);
+        next = resume;
+    }
+}
+
+bool MarketEventCursor::ready() const {
+    return bus->slots[next & (MarketEventBus::CAPACITY - 1)].load().sequence >= next;
+}
+
+bool MarketEventCursor::wait(chrono::microseconds timeout) {
+    for (size_t i = 0; i < MarketEventBus::SPIN_ROUNDS; ++i) {
+        if (ready()) return true;
+        this_thread::yield();
+    }
+
+    unique_lock<mutex> lock(bus->wait_mutex);
+    bus->waiters.fetch_add(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    bus->wait_cv.wait_for(lock, timeout, [this]() { return ready(); });
+    bus->waiters.fetch_sub(1, memory_order_relaxed);
+    return ready();
+}
+
+LatestMids::LatestMids()
+    : mids(instrument_registry.size(), 0.0), dirty(instrument_registry.size(), 0),
+      visited(instrument_registry.size(), 0) {
+    changed_ids.reserve(instrument_registry.size());
+}
+
+void LatestMids::clear_changed() {
+    for (InstrumentId id : changed_ids) dirty[id] = 0;
+    changed_ids.clear();
+}
+
+namespace {
+
+struct ConsumerRun {
+    vector<int64_t> latency_ns;
+    uint64_t out_of_order = 0;
+    uint64_t overruns = 0;
+};
+
+void consume_all(MarketEventCursor& cursor, int64_t total, int64_t sample_ms, ConsumerRun& run) {
+    int64_t expected = cursor.position();
+    auto on_event = [&](const MarketEvent& event) {
+        run.latency_ns.push_back(steady_ns() - event.publish_ns);
+        if (event.sequence != expected) run.out_of_order++;
+        expected = event.sequence + 1;
+    };
+    while (cursor.position() < total) {
+        if (sample_ms > 0) {
+            this_thread::sleep_for(chrono::milliseconds(sample_ms));
+        } else if (!cursor.wait(chrono::milliseconds(1))) {
+            continue;
+        }
+        cursor.drain(on_event);
+    }
+    run.overruns = cursor.overruns;
+}
+
+double percentile(vector<int64_t>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index] / 1e3;
+}
+
+}
+
+// Publish-to-consume latency of consumers blocked on their cursors, against
+// one that samples every 50 ms the way the analysis loop used to. Every
+// consumer must see every event once, in bus order.
+void MarketEventBus::benchmark_event_bus() {
+    cout << "\n MARKET EVENT BUS (per-consumer cursors vs 50 ms sampling)" << endl;
+    cout << string(60, '=') << endl;
+
+    const int64_t bursts = 2000;
+    const int64_t burst_size = 8;
+    const int64_t burst_gap_ns = 500000;
+    const int64_t total = bursts * burst_size;
+    const char* names[] = {"SyntheticEngine", "Volatility", "CrossAsset", "MultiLeg", "RiskManager", "50 ms sampler"};
+    const size_t consumers = sizeof(names) / sizeof(names[0]);
+
+    auto bus = make_unique<MarketEventBus>();
+    vector<unique_ptr<MarketEventCursor>> cursors;
+    vector<ConsumerRun> runs(consumers);
+    for (size_t c = 0; c < consumers; ++c) {
+        cursors.push_back(make_unique<MarketEventCursor>(*bus));
+        runs[c].latency_ns.reserve(total);
+    }
+
+    vector<thread> threads;
+    for (size_t c = 0; c < consumers; ++c) {
+        int64_t sample_ms = c + 1 == consumers ? 50 : 0;
+        threads.emplace_back([&, c, sample_ms]() { consume_all(*cursors[c], total, sample_ms, runs[c]); });
+    }
+
+    PriceLevel bid{Price::from_double(67000.0), Qty::from_double(1.0)};
+    PriceLevel ask{Price::from_double(67000.1), Qty::from_double(1.0)};
+    int64_t next_burst = steady_ns();
+    int64_t publish_total = 0;
+    for (int64_t b = 0; b < bursts; ++b) {
+        while (steady_ns() < next_burst) this_thread::yield();
+        next_burst += burst_gap_ns;
+        int64_t t0 = steady_ns();
+        for (int64_t i = 0; i < burst_size; ++i) {
+            bus->publish(i % 2 ? MarketEventType::BboChange : MarketEventType::BookUpdate,
+                         static_cast<InstrumentId>(i / 2), BboSource::Depth, bid, ask, b * burst_size + i);
+        }
+        publish_total += steady_ns() - t0;
+    }
+    for (auto& t : threads) t.join();
+
+    cout << total << " events in bursts of " << burst_size << " every " << burst_gap_ns / 1000 << " us, "
+         << fixed << setprecision(1) << publish_total / double(total) << " ns per publish" << endl;
+    cout << left << setw(18) << "Consumer" << right << setw(12) << "p50 (us)" << setw(12) << "p99 (us)"
+         << setw(10) << "Events" << setw(12) << "Reordered" << setw(10) << "Overruns" << endl;
+    for (size_t c = 0; c < consumers; ++c) {
+        ConsumerRun& run = runs[c];
+        size_t seen = run.latency_ns.size();
+        cout << left << setw(18) << names[c] << right << setw(12) << setprecision(1) << percentile(run.latency_ns, 0.50)
+             << setw(12) << percentile(run.latency_ns, 0.99) << setw(10) << seen << setw(12) << run.out_of_order
+             << setw(10) << run.overruns << endl;
+    }
+    cout << string(60, '=') << endl;
+}
@@ -1,4 +1,5 @@
 #include "multi_leg_arbitrage.hpp"
+#include "book_storage.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -14,7 +15,9 @@ MultiLegArbitrageEngine::MultiLegArbitrageEngine() {
 void MultiLegArbitrageEngine::update_market_data(const string& exchange,
                                                  const string& asset,
                                                  double spot_price,
-                                                 double futures_price) {
+                                                 double futures_price,
+                                                 double time_to_expiry) {
+    lock_guard<mutex> lock(multi_leg_mutex);
     string key = exchange + "_" + asset;
 
     RealMarketData d;
@@ -23,14 +26,29 @@ void MultiLegArbitrageEngine::update_market_data(const string& exchange,
     d.spot_price = spot_price;
     d.futures_price = futures_price;
     d.basis_bps = ((futures_price - spot_price) / spot_price) * 10000;
-    d.implied_volatility = calculate_implied_volatility_from_basis(d.basis_bps, 0.25);
+    d.time_to_expiry = time_to_expiry;
+    d.implied_volatility = calculate_implied_volatility_from_basis(d.basis_bps, time_to_expiry);
     d.timestamp = chrono::steady_clock::now();
 
     market_data[key] = d;
 }
 
+size_t MultiLegArbitrageEngine::poll_market_events() {
+    size_t count = market_events.drain([this](const MarketEvent& event) { mids.apply(event); });
+    int64_t now_s = unix_seconds();
+    mids.for_each_changed_basis([this, now_s](Exchange exchange, Asset asset, double spot, double futures) {
+        // A perpetual's basis converges over its funding interval.
+        InstrumentId futures_id = instrument_registry.id(exchange, asset, MarketType::Futures);
+        double horizon = instrument_metadata.get(futures_id).horizon_years(now_s);
+        update_market_data(exchange_name(exchange), asset_name(asset), spot, futures, horizon);
+    });
+    mids.clear_changed();
+    return count;
+}
+
 double MultiLegArbitrageEngine::calculate_implied_volatility_from_basis(double basis_bps,
                                                                         double time_to_expiry) {
+    if (time_to_expiry <= 0) return 15.0;
     double basis_pct = abs(basis_bps) / 10000.0;
     double ann_vol = basis_pct / sqrt(time_to_expiry) * 100.0;
     return max(15.0, min(ann_vol, 150.0));
@@ -60,7 +78,8 @@ vector<MultiLegStrategy> MultiLegArbitrageEngine::find_real_butterfly_spreads()
 
         double spot = d.spot_price;
         double vol = d.implied_volatility;
-        double t = 0.25;
+        double t = d.time_to_expiry;
+        if (t <= 0) continue;
 
         double atm = spot;
         double low = spot * 0.95;
@@ -192,6 +211,7 @@ vector<MultiLegStrategy> MultiLegArbitrageEngine::find_synthetic_replication() {
 }
 
 vector<MultiLegStrategy> MultiLegArbitrageEngine::scan_all_strategies() {
+    lock_guard<mutex> lock(multi_leg_mutex);
     vector<MultiLegStrategy> all;
     auto cal = find_calendar_spreads();
     auto syn = find_synthetic_replication();
@@ -34,7 +34,7 @@ void RealCrossAssetArbitrage::update_asset_price(const string& exchange, const s
     point.timestamp = chrono::steady_clock::now();
     
     auto& history = asset_price_history[price_key];
-    history.push_back(point);
+    add_sample(history, point);
     
     if (history.size() > static_cast<size_t>(history_window)) {
         history.erase(history.begin());
@@ -60,7 +60,7 @@ void RealCrossAssetArbitrage::update_asset_price(const string& exchange, const s
             
             string ratio_key = generate_ratio_key(exchange);
             auto& ratio_hist = ratio_history[ratio_key];
-            ratio_hist.push_back(ratio_point);
+            add_sample(ratio_hist, ratio_point);
             
             if (ratio_hist.size() > static_cast<size_t>(history_window)) {
                 ratio_hist.erase(ratio_hist.begin());
@@ -71,6 +71,17 @@ void RealCrossAssetArbitrage::update_asset_price(const string& exchange, const s
     }
 }
 
+size_t RealCrossAssetArbitrage::poll_market_events() {
+    size_t count = market_events.drain([this](const MarketEvent& event) { mids.apply(event); });
+    for (InstrumentId id : mids.changed()) {
+        const InstrumentInfo& info = instrument_registry.info(id);
+        if (info.market != MarketType::Spot || mids.mid(id) <= 0) continue;
+        update_asset_price(exchange_name(info.exchange), asset_name(info.asset), mids.mid(id));
+    }
+    mids.clear_changed();
+    return count;
+}
+
 double RealCrossAssetArbitrage::calculate_ratio_fair_value(const vector<CrossAssetRatio>& history) {
     if (history.size() < 2) return 0.0; // REDUCED from 3 to 2
     
@@ -90,15 +101,17 @@ double RealCrossAssetArbitrage::calculate_ratio_fair_value(const vector<CrossAss
 double RealCrossAssetArbitrage::calculate_ratio_volatility(const vector<CrossAssetRatio>& history) {
     if (history.size() < 3) return 0.0;
     
+    // Normalized by elapsed time, as the points are not evenly spaced.
     vector<double> ratio_returns;
     for (size_t i = 1; i < history.size(); i++) {
-        if (history[i-1].ratio > 0) {
+        double seconds = chrono::duration<double>(history[i].timestamp - history[i-1].timestamp).count();
+        if (history[i-1].ratio > 0 && seconds > 0) {
             double return_rate = log(history[i].ratio / history[i-1].ratio);
-            ratio_returns.push_back(return_rate);
+            ratio_returns.push_back(return_rate / sqrt(seconds));
         }
     }
     
-    if (ratio_returns.empty()) return 0.0;
+    if (ratio_returns.size() < 2) return 0.0;
     
     double mean = accumulate(ratio_returns.begin(), ratio_returns.end(), 0.0) / ratio_returns.size();
     double variance = 0.0;
@@ -107,7 +120,7 @@ double RealCrossAssetArbitrage::calculate_ratio_volatility(const vector<CrossAss
     }
     variance /= (ratio_returns.size() - 1);
     
-    return sqrt(variance) * sqrt(525600) * 100; // Annualized %
+    return sqrt(variance) * sqrt(SECONDS_PER_YEAR) * 100; // Annualized %
 }
 
 vector<RealCrossAssetOpportunity> RealCrossAssetArbitrage::scan_real_cross_asset_opportunities() {
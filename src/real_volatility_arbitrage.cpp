@@ -31,7 +31,7 @@ void RealVolatilityArbitrage::update_market_data(const string& exchange, const s
     point.timestamp = chrono::steady_clock::now();
     
     auto& history = market_history[key];
-    history.push_back(point);
+    add_sample(history, point);
     
     if (history.size() > static_cast<size_t>(history_window)) {
         history.erase(history.begin());
@@ -52,18 +52,30 @@ void RealVolatilityArbitrage::update_market_data(const string& exchange, const s
     }
 }
 
+size_t RealVolatilityArbitrage::poll_market_events() {
+    size_t count = market_events.drain([this](const MarketEvent& event) { mids.apply(event); });
+    mids.for_each_changed_basis([this](Exchange exchange, Asset asset, double spot, double futures) {
+        update_market_data(exchange_name(exchange), asset_name(asset), spot, futures);
+    });
+    mids.clear_changed();
+    return count;
+}
+
 double RealVolatilityArbitrage::calculate_realized_volatility(const vector<MarketDataPoint>& history) {
     if (history.size() < 3) return 0.0; 
     
+    // Returns per sqrt(second) of the time each one actually spans: the
+    // newest point may still be inside its interval.
     vector<double> returns;
     for (size_t i = 1; i < history.size(); i++) {
-        if (history[i-1].spot_price > 0) {
+        double seconds = chrono::duration<double>(history[i].timestamp - history[i-1].timestamp).count();
+        if (history[i-1].spot_price > 0 && seconds > 0) {
             double return_rate = log(history[i].spot_price / history[i-1].spot_price);
-            returns.push_back(return_rate);
+            returns.push_back(return_rate / sqrt(seconds));
         }
     }
     
-    if (returns.empty()) return 0.0;
+    if (returns.size() < 2) return 0.0;
     
     double mean = accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
     double variance = 0.0;
@@ -72,7 +84,7 @@ double RealVolatilityArbitrage::calculate_realized_volatility(const vector<Marke
     }
     variance /= (returns.size() - 1);
     
-    double vol = sqrt(variance) * sqrt(525600) * 100; // 525600 minutes per year
+    double vol = sqrt(variance) * sqrt(SECONDS_PER_YEAR) * 100;
     return min(vol, 200.0); // Cap at 200%
 }
 
@@ -81,11 +93,13 @@ double RealVolatilityArbitrage::calculate_basis_implied_volatility(const vector<
     
     vector<double> basis_changes;
     for (size_t i = 1; i < history.size(); i++) {
+        double seconds = chrono::duration<double>(history[i].timestamp - history[i-1].timestamp).count();
+        if (seconds <= 0) continue;
         double basis_change = history[i].basis_bps - history[i-1].basis_bps;
-        basis_changes.push_back(basis_change);
+        basis_changes.push_back(basis_change / sqrt(seconds));
     }
     
-    if (basis_changes.empty()) return 0.0;
+    if (basis_changes.size() < 2) return 0.0;
     
     double mean = accumulate(basis_changes.begin(), basis_changes.end(), 0.0) / basis_changes.size();
     double variance = 0.0;
@@ -94,7 +108,7 @@ double RealVolatilityArbitrage::calculate_basis_implied_volatility(const vector<
     }
     variance /= (basis_changes.size() - 1);
     
-    double basis_vol = sqrt(variance) * sqrt(525600); // Annualized
+    double basis_vol = sqrt(variance) * sqrt(SECONDS_PER_YEAR); // Annualized
     double implied_vol_proxy = basis_vol * 0.1; // Scale factor for crypto markets
     
     return min(implied_vol_proxy, 150.0);
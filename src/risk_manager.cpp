@@ -9,60 +9,7 @@ using namespace std;
 
 RiskManager* global_risk_manager = nullptr;
 
-static double mid_price_from_books(const std::string& exch, const std::string& instr) {
-    lock_guard<mutex> lock(book_mutex);
-    if (exch == "Binance" && instr == "Bitcoin") {
-        if (spot_bids.empty() || spot_asks.empty()) return 0.0;
-        return (spot_bids.rbegin()->first + spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Binance" && instr == "Bitcoin_Futures") {
-        if (futures_bids.empty() || futures_asks.empty()) return 0.0;
-        return (futures_bids.rbegin()->first + futures_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Binance" && instr == "Ethereum") {
-        if (eth_spot_bids.empty() || eth_spot_asks.empty()) return 0.0;
-        return (eth_spot_bids.rbegin()->first + eth_spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Binance" && instr == "Ethereum_Futures") {
-        if (eth_futures_bids.empty() || eth_futures_asks.empty()) return 0.0;
-        return (eth_futures_bids.rbegin()->first + eth_futures_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Bybit" && instr == "Bitcoin") {
-        if (bybit_spot_bids.empty() || bybit_spot_asks.empty()) return 0.0;
-        return (bybit_spot_bids.rbegin()->first + bybit_spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Bybit" && instr == "Bitcoin_Futures") {
-        if (bybit_futures_bids.empty() || bybit_futures_asks.empty()) return 0.0;
-        return (bybit_futures_bids.rbegin()->first + bybit_futures_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Bybit" && instr == "Ethereum") {
-        if (eth_bybit_spot_bids.empty() || eth_bybit_spot_asks.empty()) return 0.0;
-        return (eth_bybit_spot_bids.rbegin()->first + eth_bybit_spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "Bybit" && instr == "Ethereum_Futures") {
-        if (eth_bybit_futures_bids.empty() || eth_bybit_futures_asks.empty()) return 0.0;
-        return (eth_bybit_futures_bids.rbegin()->first + eth_bybit_futures_asks.begin()->first) / 2.0;
-    }
-    if (exch == "OKX" && instr == "Bitcoin") {
-        if (okx_spot_bids.empty() || okx_spot_asks.empty()) return 0.0;
-        return (okx_spot_bids.rbegin()->first + okx_spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "OKX" && instr == "Bitcoin_Futures") {
-        if (okx_futures_bids.empty() || okx_futures_asks.empty()) return 0.0;
-        return (okx_futures_bids.rbegin()->first + okx_futures_asks.begin()->first) / 2.0;
-    }
-    if (exch == "OKX" && instr == "Ethereum") {
-        if (eth_okx_spot_bids.empty() || eth_okx_spot_asks.empty()) return 0.0;
-        return (eth_okx_spot_bids.rbegin()->first + eth_okx_spot_asks.begin()->first) / 2.0;
-    }
-    if (exch == "OKX" && instr == "Ethereum_Futures") {
-        if (eth_okx_futures_bids.empty() || eth_okx_futures_asks.empty()) return 0.0;
-        return (eth_okx_futures_bids.rbegin()->first + eth_okx_futures_asks.begin()->first) / 2.0;
-    }
-    return 0.0;
-}
-
-RiskManager::RiskManager(const RiskConfig& cfg) : config(cfg) {
+RiskManager::RiskManager(const RiskConfig& cfg) : config(cfg), book_mids(instrument_registry.size(), 0.0) {
     current_metrics.total_capital = config.initial_capital;
     current_metrics.available_capital = config.initial_capital;
     current_metrics.total_exposure = 0.0;
@@ -152,13 +99,21 @@ void RiskManager::process_arbitrage_opportunity(const string& exchange, const st
     signal.exchange = exchange;
     signal.instrument = instrument;
     signal.action = profit > 0 ? "BUY" : "SELL";
-    signal.expected_profit = abs(profit);
     signal.confidence_score = confidence;
     signal.strategy_type = strategy_type;
-    signal.price = mid_price_from_books(exchange, instrument);
-    if (signal.price == 0.0) return;
+    InstrumentId id = instrument_registry.find(exchange, instrument);
+    if (id == INVALID_INSTRUMENT) return;
+    const InstrumentMetadata& terms = instrument_metadata.get(id);
+    // Opening and closing both cross the spread at the taker rate.
+    signal.expected_profit = abs(profit) - 2.0 * terms.fee_tier().taker_rate;
+    Price mid = instrument_registry.book(id).snapshot().mid_price();
+    if (mid.is_zero()) return;
+    signal.price = mid.to_double() * terms.contract_multiplier;
     double recommended_size;
     if (evaluate_opportunity(signal, recommended_size)) {
+        Qty lots = terms.spec.round_down_to_lot(Qty::from_double(recommended_size));
+        if (lots.to_double() < config.min_trade_size) return;
+        recommended_size = lots.to_double();
         lock_guard<mutex> lock(risk_mutex);
         signal.risk_amount = recommended_size * signal.price * config.max_risk_per_trade;
         pending_signals.push_back(signal);
@@ -170,7 +125,7 @@ void RiskManager::update_risk_metrics() {
     double total_unrealized_pnl = 0.0;
     for (const auto& position : positions) {
         if (position.is_active) {
-            current_metrics.total_exposure += abs(position.quantity * position.current_price);
+            current_metrics.total_exposure += abs(position.quantity * position.current_price * position.contract_multiplier);
             total_unrealized_pnl += position.unrealized_pnl;
         }
     }
@@ -293,6 +248,10 @@ bool RiskManager::open_position(const TradeSignal& signal, double actual_fill_pr
     pos.entry_time = chrono::steady_clock::now();
     pos.is_active = true;
     pos.strategy_id = signal.strategy_type;
+    pos.instrument_id = instrument_registry.find(signal.exchange, signal.instrument);
+    if (pos.instrument_id != INVALID_INSTRUMENT) {
+        pos.contract_multiplier = instrument_metadata.get(pos.instrument_id).contract_multiplier;
+    }
     positions.push_back(pos);
     current_metrics.total_trades++;
     return true;
@@ -303,7 +262,7 @@ bool RiskManager::close_position(const string& position_id, double exit_price) {
     for (auto& pos : positions) {
         if (pos.strategy_id == position_id && pos.is_active) {
             pos.is_active = false;
-            pos.realized_pnl = (exit_price - pos.entry_price) * pos.quantity;
+            pos.realized_pnl = (exit_price - pos.entry_price) * pos.quantity * pos.contract_multiplier;
             current_metrics.daily_pnl += pos.realized_pnl;
             if (pos.realized_pnl > 0) {
                 current_metrics.winning_trades++;
@@ -321,12 +280,31 @@ void RiskManager::update_positions(const unordered_map<string, double>& current_
             auto it = current_prices.find(pos.instrument);
             if (it != current_prices.end()) {
                 pos.current_price = it->second;
-                pos.unrealized_pnl = (pos.current_price - pos.entry_price) * pos.quantity;
+                pos.unrealized_pnl = (pos.current_price - pos.entry_price) * pos.quantity * pos.contract_multiplier;
             }
         }
     }
 }
 
+size_t RiskManager::poll_market_events() {
+    size_t count = market_events.drain([this](const MarketEvent& event) {
+        if (event.type != MarketEventType::BookUpdate || !event.has_quotes()) return;
+        if (book_mids[event.instrument] == 0.0) marked.push_back(event.instrument);
+        book_mids[event.instrument] = event.mid();
+    });
+    if (marked.empty()) return count;
+    
+    lock_guard<mutex> lock(risk_mutex);
+    for (auto& pos : positions) {
+        if (!pos.is_active || pos.instrument_id == INVALID_INSTRUMENT || book_mids[pos.instrument_id] == 0.0) continue;
+        pos.current_price = book_mids[pos.instrument_id];
+        pos.unrealized_pnl = (pos.current_price - pos.entry_price) * pos.quantity * pos.contract_multiplier;
+    }
+    for (InstrumentId id : marked) book_mids[id] = 0.0;
+    marked.clear();
+    return count;
+}
+
 void RiskManager::update_config(const RiskConfig& new_config) {
     lock_guard<mutex> lock(risk_mutex);
     config = new_config;
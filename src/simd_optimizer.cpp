@@ -179,6 +179,58 @@ void SIMDOptimizer::calculate_synthetic_prices_simd(
 #endif
 }
 
+void SIMDOptimizer::calculate_cross_edges_simd(
+    const float* net_bids,
+    const float* inv_gross_asks,
+    size_t count,
+    float inv_cost,
+    float proceeds,
+    float* buy_edges,
+    float* sell_edges) {
+    
+#ifdef __AVX2__
+    __m256 inv_cost_vec = _mm256_set1_ps(inv_cost);
+    __m256 proceeds_vec = _mm256_set1_ps(proceeds);
+    __m256 one = _mm256_set1_ps(1.0f);
+    
+    for (size_t offset = 0; offset < count; offset += 8) {
+        __m256 bids_vec = _mm256_loadu_ps(net_bids + offset);
+        __m256 asks_vec = _mm256_loadu_ps(inv_gross_asks + offset);
+        
+        __m256 buy_vec = _mm256_sub_ps(_mm256_mul_ps(bids_vec, inv_cost_vec), one);
+        __m256 sell_vec = _mm256_sub_ps(_mm256_mul_ps(asks_vec, proceeds_vec), one);
+        
+        _mm256_storeu_ps(buy_edges + offset, buy_vec);
+        _mm256_storeu_ps(sell_edges + offset, sell_vec);
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        buy_edges[i] = net_bids[i] * inv_cost - 1.0f;
+        sell_edges[i] = inv_gross_asks[i] * proceeds - 1.0f;
+    }
+#endif
+}
+
+size_t SIMDOptimizer::count_above_simd(const float* values, size_t count, float threshold) {
+    size_t above = 0;
+    
+#ifdef __AVX2__
+    __m256 threshold_vec = _mm256_set1_ps(threshold);
+    
+    for (size_t offset = 0; offset < count; offset += 8) {
+        __m256 data_vec = _mm256_loadu_ps(values + offset);
+        __m256 comparison = _mm256_cmp_ps(data_vec, threshold_vec, _CMP_GT_OQ);
+        above += __builtin_popcount(_mm256_movemask_ps(comparison));
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] > threshold) above++;
+    }
+#endif
+    
+    return above;
+}
+
 float SIMDOptimizer::calculate_mean_simd(const vector<float>& values) {
     if (values.empty()) return 0.0f;
     
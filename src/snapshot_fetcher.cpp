@@ -0,0 +1,108 @@
+#include "snapshot_fetcher.hpp"
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <chrono>
+#include <memory>
+
+using namespace std;
+
+namespace beast = boost::beast;
+namespace http = boost::beast::http;
+namespace asio = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+
+// Same trust settings as the WebSocket TLS context in the feed handlers.
+asio::ssl::context& tls_context() {
+    static asio::ssl::context context = [] {
+        asio::ssl::context ctx(asio::ssl::context::sslv23);
+        ctx.set_verify_mode(asio::ssl::verify_none);
+        return ctx;
+    }();
+    return context;
+}
+
+// One request's state. Every completion handler holds a shared_ptr to it, so
+// it lives exactly as long as the chain of operations.
+class HttpsRequest : public enable_shared_from_this<HttpsRequest> {
+    static constexpr auto TIMEOUT = chrono::seconds(5);
+
+    tcp::resolver resolver;
+    beast::ssl_stream<beast::tcp_stream> stream;
+    beast::flat_buffer buffer;
+    http::request<http::empty_body> request;
+    http::response_parser<http::string_body> response;
+    function<void(bool, string)> done;
+
+    void finish(bool ok) {
+        if (!done) return;
+        auto callback = move(done);
+        done = nullptr;
+        callback(ok, ok ? move(response.get().body()) : string());
+    }
+
+public:
+    HttpsRequest(asio::io_service& io, const string& host, const string& target,
+                 function<void(bool, string)> on_done)
+        : resolver(io), stream(io, tls_context()), done(move(on_done)) {
+        request.version(11);
+        request.method(http::verb::get);
+        request.target(target);
+        request.set(http::field::host, host);
+        request.set(http::field::user_agent, "Arbit");
+        // A limit=1000 depth snapshot is a few hundred KB.
+        response.body_limit(8 * 1024 * 1024);
+    }
+
+    void run(const string& host) {
+        if (!SSL_set_tlsext_host_name(stream.native_handle(), host.c_str())) {
+            finish(false);
+            return;
+        }
+        beast::get_lowest_layer(stream).expires_after(TIMEOUT);
+        resolver.async_resolve(host, "443",
+            [self = shared_from_this()](beast::error_code ec, tcp::resolver::results_type results) {
+                if (ec) return self->finish(false);
+                self->connect(results);
+            });
+    }
+
+private:
+    void connect(const tcp::resolver::results_type& results) {
+        beast::get_lowest_layer(stream).async_connect(results,
+            [self = shared_from_this()](beast::error_code ec, const tcp::endpoint&) {
+                if (ec) return self->finish(false);
+                self->stream.async_handshake(asio::ssl::stream_base::client,
+                    [self](beast::error_code ec) {
+                        if (ec) return self->finish(false);
+                        self->send();
+                    });
+            });
+    }
+
+    void send() {
+        http::async_write(stream, request,
+            [self = shared_from_this()](beast::error_code ec, size_t) {
+                if (ec) return self->finish(false);
+                http::async_read(self->stream, self->buffer, self->response,
+                    [self](beast::error_code ec, size_t) {
+                        bool ok = !ec && self->response.get().result() == http::status::ok;
+                        self->finish(ok);
+                        // Best effort; the connection is not reused.
+                        beast::error_code ignored;
+                        beast::get_lowest_layer(self->stream).socket().shutdown(tcp::socket::shutdown_both, ignored);
+                    });
+            });
+    }
+};
+
+}
+
+void https_get(asio::io_service& io, const string& host, const string& target,
+               function<void(bool ok, string body)> done) {
+    make_shared<HttpsRequest>(io, host, target, move(done))->run(host);
+}
@@ -5,12 +5,65 @@
 #include <ctime>
 #include <vector>
 #include <algorithm>
+#include <random>
+#include <time.h>
 
 using namespace std;
 
 SyntheticEngine* global_synthetic_engine = nullptr;
 
-SyntheticEngine::SyntheticEngine(const ConfigThresholds& cfg) : config(cfg) {
+namespace {
+
+int64_t steady_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+// Every futures leg the feeds carry is a linear perpetual, so each venue's
+// spot is priced off its perpetual and funding. Dated futures would join as
+// CostOfCarry rows.
+const vector<SyntheticPairDefinition>& default_synthetic_pair_table() {
+    static const vector<SyntheticPairDefinition> table = {
+        {Exchange::Binance, Asset::Bitcoin,  MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+        {Exchange::Bybit,   Asset::Bitcoin,  MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+        {Exchange::OKX,     Asset::Bitcoin,  MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+        {Exchange::Binance, Asset::Ethereum, MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+        {Exchange::Bybit,   Asset::Ethereum, MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+        {Exchange::OKX,     Asset::Ethereum, MarketType::Spot, MarketType::Futures, PricingModel::PerpetualFunding},
+    };
+    return table;
+}
+
+SyntheticEngine::SyntheticEngine(const ConfigThresholds& cfg, const vector<SyntheticPairDefinition>& table)
+    : config(cfg), instrument_pairs(instrument_registry.size()) {
+    for (const SyntheticPairDefinition& def : table) {
+        InstrumentId priced = instrument_registry.id(def.exchange, def.asset, def.priced);
+        InstrumentId reference = instrument_registry.id(def.exchange, def.asset, def.reference);
+        if (priced == INVALID_INSTRUMENT || reference == INVALID_INSTRUMENT) continue;
+        
+        bool perpetual = def.model == PricingModel::PerpetualFunding;
+        if (!perpetual && !instrument_metadata.get(priced).dated()) {
+            cout << "[SYNTHETIC ENGINE] Skipping carry pair on undated "
+                 << instrument_registry.info(priced).full_name() << endl;
+            continue;
+        }
+        has_dated_pairs |= !perpetual;
+        SyntheticPairId id = static_cast<SyntheticPairId>(pairs.size());
+        pairs.push_back({def.exchange, def.asset, priced, reference, def.model, exchange_name(def.exchange),
+                         string(asset_name(def.asset)) + (perpetual ? " spot_vs_perpetual" : " futures_vs_spot")});
+        pricing.push_back({priced, reference, 0.0, 1.0});
+        instrument_pairs[priced].push_back(id);
+        instrument_pairs[reference].push_back(id);
+    }
+    quotes = make_unique<SeqLock<SyntheticQuote>[]>(pairs.size());
+    pair_funding = make_unique<atomic<double>[]>(pairs.size());
+    for (size_t p = 0; p < pairs.size(); ++p) pair_funding[p].store(NAN, memory_order_relaxed);
+    pair_dirty.assign(pairs.size(), 0);
+    dirty_pairs.reserve(pairs.size());
+    refresh_factors();
+    dirty_pairs.clear();
+    fill(pair_dirty.begin(), pair_dirty.end(), 0);
     global_synthetic_engine = this;
 }
 
@@ -33,199 +86,133 @@ void SyntheticEngine::stop() {
     cout << "[SYNTHETIC ENGINE]  Stopped synthetic pricing calculations" << endl;
 }
 
-double SyntheticEngine::calculate_synthetic_spot_from_perp(double perp_price, double funding_rate) {
-    double daily_funding_adjustment = perp_price * funding_rate;
-    return perp_price - daily_funding_adjustment;
-}
-
-double SyntheticEngine::calculate_synthetic_futures_price(double spot_price, double time_to_expiry, double rate) {
-    return spot_price * exp(rate * time_to_expiry);
-}
-
 double SyntheticEngine::calculate_mispricing_percent(double real_price, double synthetic_price) {
     if (synthetic_price == 0.0) return 0.0;
     return ((real_price - synthetic_price) / synthetic_price) * 100.0;
 }
 
-double SyntheticEngine::get_current_funding_rate(const string& exchange, const string& symbol) {
-    lock_guard<mutex> lock(funding_mutex);
-    string key = exchange + "_" + symbol;
-    auto it = funding_rates.find(key);
-    if (it != funding_rates.end()) {
-        return it->second;
+void SyntheticEngine::mark_dirty(SyntheticPairId id) {
+    if (pair_dirty[id]) return;
+    pair_dirty[id] = 1;
+    dirty_pairs.push_back(id);
+}
+
+void SyntheticEngine::refresh_factor(SyntheticPairId id, int64_t now_s) {
+    const SyntheticPair& pair = pairs[id];
+    PairPricing& entry = pricing[id];
+    double rate, factor;
+    if (pair.model == PricingModel::PerpetualFunding) {
+        rate = pair_funding[id].load(memory_order_relaxed);
+        if (isnan(rate)) {
+            FundingState funding = instrument_registry.funding(pair.reference).load();
+            rate = funding.has_rate ? funding.funding_rate : config.default_funding_rate;
+        }
+        factor = 1.0 - rate;
+    } else {
+        rate = config.risk_free_rate;
+        factor = exp(rate * instrument_metadata.get(pair.priced).years_to_expiry(now_s));
     }
-    return config.default_funding_rate;
+    if (rate == entry.rate && factor == entry.factor) return;
+    entry.rate = rate;
+    entry.factor = factor;
+    mark_dirty(id);
 }
 
-double SyntheticEngine::estimate_time_to_expiry() {
-    return 0.25; // 3 months
+void SyntheticEngine::refresh_factors() {
+    int64_t now_s = unix_seconds();
+    for (SyntheticPairId id = 0; id < pairs.size(); ++id) refresh_factor(id, now_s);
 }
 
 string SyntheticEngine::generate_key(const string& exchange, const string& market) {
     return exchange + "_" + market;
 }
 
+void SyntheticEngine::reprice(SyntheticPairId id, int64_t now_ns) {
+    const PairPricing& entry = pricing[id];
+    double priced_mid = mids.mid(entry.priced);
+    double reference_mid = mids.mid(entry.reference);
+    if (priced_mid <= 0 || reference_mid <= 0) return;
+    
+    SyntheticQuote quote;
+    quote.real_price = priced_mid;
+    quote.synthetic_price = reference_mid * entry.factor;
+    quote.funding_rate = entry.rate;
+    quote.mispricing_percent = calculate_mispricing_percent(quote.real_price, quote.synthetic_price);
+    quote.update_ns = now_ns;
+    quote.is_valid = abs(quote.mispricing_percent) >= config.min_mispricing_percent;
+    if (quote.is_valid) {
+        // Rich priced leg: sell its bids against the reference's asks at
+        // fair value; cheap, the other way round.
+        BookSnapshot priced_book = instrument_registry.book(entry.priced).snapshot();
+        BookSnapshot reference_book = instrument_registry.book(entry.reference).snapshot();
+        const InstrumentMetadata& priced_terms = instrument_metadata.get(entry.priced);
+        const InstrumentMetadata& reference_terms = instrument_metadata.get(entry.reference);
+        double priced_fee = priced_terms.fee_tier().taker_rate;
+        double reference_fee = reference_terms.fee_tier().taker_rate;
+        ExecutableEdge trade =
+            quote.mispricing_percent > 0
+                ? executable_edge({reference_book, reference_terms.contract_multiplier, entry.factor * (1.0 + reference_fee)},
+                                  {priced_book, priced_terms.contract_multiplier, 1.0 - priced_fee})
+                : executable_edge({priced_book, priced_terms.contract_multiplier, 1.0 + priced_fee},
+                                  {reference_book, reference_terms.contract_multiplier, entry.factor * (1.0 - reference_fee)});
+        quote.executable_size = trade.quantity;
+        quote.executable_profit = trade.profit();
+    }
+    quotes[id].store(quote);
+}
 
+size_t SyntheticEngine::reprice_changed() {
+    for (InstrumentId instrument : mids.changed()) {
+        for (SyntheticPairId id : instrument_pairs[instrument]) mark_dirty(id);
+    }
+    mids.clear_changed();
+    
+    int64_t now_ns = steady_ns();
+    for (SyntheticPairId id : dirty_pairs) {
+        reprice(id, now_ns);
+        pair_dirty[id] = 0;
+    }
+    size_t repriced = dirty_pairs.size();
+    dirty_pairs.clear();
+    return repriced;
+}
 
+// Reprices as soon as a BBO changes, and only the pairs it is a leg of;
+// calculation_interval_ms only bounds how long a quiet market leaves the
+// loop waiting. A new rate, or a dated contract's carry decaying, reprices
+// just the pairs whose factor moved.
 void SyntheticEngine::calculation_loop() {
     while (running) {
         try {
-            {
-                lock_guard<mutex> book_lock(book_mutex);
-                lock_guard<mutex> synthetic_lock(synthetic_mutex);
-                
-                // **BITCOIN CALCULATIONS**
-                
-                // **BINANCE BITCOIN**
-                if (!spot_bids.empty() && !spot_asks.empty() && 
-                    !futures_bids.empty() && !futures_asks.empty()) {
-                    
-                    double spot_mid = (spot_bids.rbegin()->first + spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (futures_bids.rbegin()->first + futures_asks.begin()->first) / 2.0;
-                    
-                    double synthetic_future = calculate_synthetic_futures_price(
-                        spot_mid, estimate_time_to_expiry(), config.risk_free_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(futures_mid, synthetic_future);
-                    
-                    SyntheticPrice binance_calc;
-                    binance_calc.real_price = futures_mid;
-                    binance_calc.synthetic_price = synthetic_future;
-                    binance_calc.mispricing_percent = mispricing;
-                    binance_calc.funding_rate = config.risk_free_rate;
-                    binance_calc.exchange = "Binance";
-                    binance_calc.instrument_type = "Bitcoin futures_vs_spot";  
-                    binance_calc.timestamp = chrono::steady_clock::now();
-                    binance_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["Binance_Bitcoin_futures_vs_spot"] = binance_calc;
-                }
-                
-                // **OKX BITCOIN**
-                if (!okx_spot_bids.empty() && !okx_spot_asks.empty() && 
-                    !okx_futures_bids.empty() && !okx_futures_asks.empty()) {
-                    
-                    double spot_mid = (okx_spot_bids.rbegin()->first + okx_spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (okx_futures_bids.rbegin()->first + okx_futures_asks.begin()->first) / 2.0;
-                    
-                    double synthetic_future = calculate_synthetic_futures_price(
-                        spot_mid, estimate_time_to_expiry(), config.risk_free_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(futures_mid, synthetic_future);
-                    
-                    SyntheticPrice okx_calc;
-                    okx_calc.real_price = futures_mid;
-                    okx_calc.synthetic_price = synthetic_future;
-                    okx_calc.mispricing_percent = mispricing;
-                    okx_calc.funding_rate = config.risk_free_rate;
-                    okx_calc.exchange = "OKX";
-                    okx_calc.instrument_type = "Bitcoin futures_vs_spot";  
-                    okx_calc.timestamp = chrono::steady_clock::now();
-                    okx_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["OKX_Bitcoin_futures_vs_spot"] = okx_calc;
-                }
-                
-                // **BYBIT BITCOIN** (keeping original perpetual logic)
-                if (!bybit_spot_bids.empty() && !bybit_spot_asks.empty() && 
-                    !bybit_futures_bids.empty() && !bybit_futures_asks.empty()) {
-                    
-                    double spot_mid = (bybit_spot_bids.rbegin()->first + bybit_spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (bybit_futures_bids.rbegin()->first + bybit_futures_asks.begin()->first) / 2.0;
-                    
-                    double funding_rate = get_current_funding_rate("Bybit", "BTCUSDT");
-                    double synthetic_spot = calculate_synthetic_spot_from_perp(futures_mid, funding_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(spot_mid, synthetic_spot);
-                    
-                    SyntheticPrice bybit_calc;
-                    bybit_calc.real_price = spot_mid;
-                    bybit_calc.synthetic_price = synthetic_spot;
-                    bybit_calc.mispricing_percent = mispricing;
-                    bybit_calc.funding_rate = funding_rate;
-                    bybit_calc.exchange = "Bybit";
-                    bybit_calc.instrument_type = "Bitcoin spot_vs_perpetual"; 
-                    bybit_calc.timestamp = chrono::steady_clock::now();
-                    bybit_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["Bybit_Bitcoin_spot_vs_perpetual"] = bybit_calc;
-                }
-                
-                
-                // **BINANCE ETHEREUM**
-                if (!eth_spot_bids.empty() && !eth_spot_asks.empty() && 
-                    !eth_futures_bids.empty() && !eth_futures_asks.empty()) {
-                    
-                    double spot_mid = (eth_spot_bids.rbegin()->first + eth_spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (eth_futures_bids.rbegin()->first + eth_futures_asks.begin()->first) / 2.0;
-                    
-                    double synthetic_future = calculate_synthetic_futures_price(
-                        spot_mid, estimate_time_to_expiry(), config.risk_free_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(futures_mid, synthetic_future);
-                    
-                    SyntheticPrice binance_eth_calc;
-                    binance_eth_calc.real_price = futures_mid;
-                    binance_eth_calc.synthetic_price = synthetic_future;
-                    binance_eth_calc.mispricing_percent = mispricing;
-                    binance_eth_calc.funding_rate = config.risk_free_rate;
-                    binance_eth_calc.exchange = "Binance";
-                    binance_eth_calc.instrument_type = "Ethereum futures_vs_spot";  
-                    binance_eth_calc.timestamp = chrono::steady_clock::now();
-                    binance_eth_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["Binance_Ethereum_futures_vs_spot"] = binance_eth_calc;
-                }
-                
-                // **OKX ETHEREUM**
-                if (!eth_okx_spot_bids.empty() && !eth_okx_spot_asks.empty() && 
-                    !eth_okx_futures_bids.empty() && !eth_okx_futures_asks.empty()) {
-                    
-                    double spot_mid = (eth_okx_spot_bids.rbegin()->first + eth_okx_spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (eth_okx_futures_bids.rbegin()->first + eth_okx_futures_asks.begin()->first) / 2.0;
-                    
-                    double synthetic_future = calculate_synthetic_futures_price(
-                        spot_mid, estimate_time_to_expiry(), config.risk_free_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(futures_mid, synthetic_future);
-                    
-                    SyntheticPrice okx_eth_calc;
-                    okx_eth_calc.real_price = futures_mid;
-                    okx_eth_calc.synthetic_price = synthetic_future;
-                    okx_eth_calc.mispricing_percent = mispricing;
-                    okx_eth_calc.funding_rate = config.risk_free_rate;
-                    okx_eth_calc.exchange = "OKX";
-                    okx_eth_calc.instrument_type = "Ethereum futures_vs_spot"; 
-                    okx_eth_calc.timestamp = chrono::steady_clock::now();
-                    okx_eth_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["OKX_Ethereum_futures_vs_spot"] = okx_eth_calc;
-                }
-                
-                if (!eth_bybit_spot_bids.empty() && !eth_bybit_spot_asks.empty() && 
-                    !eth_bybit_futures_bids.empty() && !eth_bybit_futures_asks.empty()) {
-                    
-                    double spot_mid = (eth_bybit_spot_bids.rbegin()->first + eth_bybit_spot_asks.begin()->first) / 2.0;
-                    double futures_mid = (eth_bybit_futures_bids.rbegin()->first + eth_bybit_futures_asks.begin()->first) / 2.0;
-                    
-                    double funding_rate = get_current_funding_rate("Bybit", "ETHUSDT");
-                    double synthetic_spot = calculate_synthetic_spot_from_perp(futures_mid, funding_rate);
-                    
-                    double mispricing = calculate_mispricing_percent(spot_mid, synthetic_spot);
-                    
-                    SyntheticPrice bybit_eth_calc;
-                    bybit_eth_calc.real_price = spot_mid;
-                    bybit_eth_calc.synthetic_price = synthetic_spot;
-                    bybit_eth_calc.mispricing_percent = mispricing;
-                    bybit_eth_calc.funding_rate = funding_rate;
-                    bybit_eth_calc.exchange = "Bybit";
-                    bybit_eth_calc.instrument_type = "Ethereum spot_vs_perpetual"; 
-                    bybit_eth_calc.timestamp = chrono::steady_clock::now();
-                    bybit_eth_calc.is_valid = abs(mispricing) >= config.min_mispricing_percent;
-                    
-                    synthetic_prices["Bybit_Ethereum_spot_vs_perpetual"] = bybit_eth_calc;
+            market_events.wait(chrono::milliseconds(config.calculation_interval_ms));
+            int64_t oldest_ns = numeric_limits<int64_t>::max();
+            market_events.drain([this, &oldest_ns](const MarketEvent& event) {
+                if (event.type == MarketEventType::Funding) {
+                    // Only the pairs priced off this perpetual move.
+                    for (SyntheticPairId id : instrument_pairs[event.instrument]) {
+                        if (pairs[id].model == PricingModel::PerpetualFunding && pairs[id].reference == event.instrument) {
+                            refresh_factor(id, 0);
+                        }
+                    }
+                    return;
                 }
+                mids.apply(event);
+                oldest_ns = min(oldest_ns, event.publish_ns);
+            });
+            
+            int64_t now_ns = steady_ns();
+            bool dated_due = has_dated_pairs && now_ns >= next_carry_refresh_ns;
+            if (carry_stale.exchange(false, memory_order_acquire) || dated_due) {
+                refresh_factors();
+                next_carry_refresh_ns = now_ns + CARRY_REFRESH_NS;
             }
+            bool quotes_changed = !mids.changed().empty();
+            if (!quotes_changed && dirty_pairs.empty()) continue;
+            
+            size_t repriced = reprice_changed();
+            if (quotes_changed) detection_latency.record(steady_ns() - oldest_ns);
+            pairs_repriced.fetch_add(repriced, memory_order_relaxed);
+            bursts.fetch_add(1, memory_order_relaxed);
             
             if (config.enable_logging) {
                 log_synthetic_calculations();
@@ -234,20 +221,33 @@ void SyntheticEngine::calculation_loop() {
         } catch (const exception& e) {
             cout << "[SYNTHETIC ENGINE ERROR] " << e.what() << endl;
         }
-        
-        this_thread::sleep_for(chrono::milliseconds(config.calculation_interval_ms));
     }
 }
 
+SyntheticPrice SyntheticEngine::to_price(SyntheticPairId id, const SyntheticQuote& quote) const {
+    SyntheticPrice price;
+    price.real_price = quote.real_price;
+    price.synthetic_price = quote.synthetic_price;
+    price.mispricing_percent = quote.mispricing_percent;
+    price.funding_rate = quote.funding_rate;
+    price.executable_size = quote.executable_size;
+    price.executable_profit = quote.executable_profit;
+    price.exchange = pairs[id].exchange_label;
+    price.instrument_type = pairs[id].instrument_type;
+    price.timestamp = chrono::steady_clock::time_point(chrono::nanoseconds(quote.update_ns));
+    price.is_valid = quote.is_valid;
+    return price;
+}
+
 vector<SyntheticPrice> SyntheticEngine::get_mispricing_opportunities() {
-    lock_guard<mutex> lock(synthetic_mutex);
     vector<SyntheticPrice> opportunities;
     
-    for (const auto& pair : synthetic_prices) {
-        if (pair.second.is_valid && 
-            abs(pair.second.mispricing_percent) >= config.min_mispricing_percent &&
-            abs(pair.second.mispricing_percent) <= config.max_mispricing_percent) {
-            opportunities.push_back(pair.second);
+    for (SyntheticPairId id = 0; id < pairs.size(); ++id) {
+        SyntheticQuote quote = quotes[id].load();
+        if (quote.update_ns != 0 && quote.is_valid && 
+            abs(quote.mispricing_percent) >= config.min_mispricing_percent &&
+            abs(quote.mispricing_percent) <= config.max_mispricing_percent) {
+            opportunities.push_back(to_price(id, quote));
         }
     }
     
@@ -315,6 +315,12 @@ void SyntheticEngine::print_mispricing_opportunities() {
             cout << "   Real Price: $" << fixed << setprecision(2) << opp.real_price << endl;
             cout << "   Fair Price: $" << fixed << setprecision(2) << opp.synthetic_price << endl;
             cout << "   Mispricing: " << fixed << setprecision(3) << opp.mispricing_percent << "%" << endl;
+            if (opp.executable_size > 0) {
+                cout << "   Executable now: " << setprecision(4) << opp.executable_size << " units for $"
+                     << setprecision(2) << opp.executable_profit << " after taker fees" << endl;
+            } else {
+                cout << "   Executable now: nothing at current depth after taker fees" << endl;
+            }
             
             string asset_type = "Bitcoin";
             if (opp.instrument_type.find("Ethereum") != string::npos) {
@@ -361,45 +367,164 @@ void SyntheticEngine::log_synthetic_calculations() {
     log_counter++;
     
     if (log_counter % 10 == 0) {
-        lock_guard<mutex> lock(synthetic_mutex);
-        
         cout << "\n [SYNTHETIC ENGINE] Calculation Summary #" << log_counter << endl;
         
-        if (synthetic_prices.empty()) {
-            cout << "  No synthetic calculations available yet..." << endl;
-            return;
-        }
-        
-        for (const auto& pair : synthetic_prices) {
-            const auto& calc = pair.second;
+        bool any = false;
+        for (SyntheticPairId id = 0; id < pairs.size(); ++id) {
+            SyntheticQuote calc = quotes[id].load();
+            if (calc.update_ns == 0) continue;
+            any = true;
             string status = calc.is_valid ? " No" : " Yes";
             
-            cout << "  " << calc.exchange << " " << calc.instrument_type 
+            cout << "  " << pairs[id].exchange_label << " " << pairs[id].instrument_type 
                  << ": " << fixed << setprecision(3) << calc.mispricing_percent 
                  << "% mispricing" << status << endl;
         }
+        if (!any) {
+            cout << "  No synthetic calculations available yet..." << endl;
+        }
     }
 }
 
 void SyntheticEngine::update_funding_rate(const string& exchange, const string& symbol, double rate) {
-    lock_guard<mutex> lock(funding_mutex);
     string key = exchange + "_" + symbol;
-    funding_rates[key] = rate;
+    for (SyntheticPairId id = 0; id < pairs.size(); ++id) {
+        if (pairs[id].model == PricingModel::PerpetualFunding && pairs[id].exchange_label == exchange &&
+            instrument_registry.info(pairs[id].reference).symbol == symbol) {
+            pair_funding[id].store(rate, memory_order_relaxed);
+        }
+    }
+    carry_stale.store(true, memory_order_release);
     cout << "[SYNTHETIC ENGINE] Updated funding rate: " << key << " = " 
          << fixed << setprecision(4) << (rate * 100) << "%" << endl;
 }
 
 void SyntheticEngine::set_config(const ConfigThresholds& cfg) {
     config = cfg;
+    carry_stale.store(true, memory_order_release);
     cout << "[SYNTHETIC ENGINE] Configuration updated" << endl;
 }
 
 SyntheticPrice SyntheticEngine::get_synthetic_price(const string& exchange, const string& market) {
-    lock_guard<mutex> lock(synthetic_mutex);
     string key = generate_key(exchange, market);
-    auto it = synthetic_prices.find(key);
-    if (it != synthetic_prices.end()) {
-        return it->second;
+    for (SyntheticPairId id = 0; id < pairs.size(); ++id) {
+        string type = pairs[id].instrument_type;
+        replace(type.begin(), type.end(), ' ', '_');
+        SyntheticQuote quote = quotes[id].load();
+        if (quote.update_ns != 0 && generate_key(pairs[id].exchange_label, type) == key) {
+            return to_price(id, quote);
+        }
     }
     return SyntheticPrice{};
 }
+
+namespace {
+
+int64_t thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+}
+
+// Pricing-thread CPU per quote change under a replayed stream: repricing
+// every pair into string-keyed SyntheticPrice records under a mutex, as the
+// engine used to, against repricing only the changed instrument's pairs
+// from the pair table's cached factors into their seqlocks. Both must end
+// on the same prices.
+void SyntheticEngine::benchmark_incremental_repricing() {
+    cout << "\n SYNTHETIC REPRICING (every pair vs changed pairs only)" << endl;
+    cout << string(60, '=') << endl;
+    
+    ConfigThresholds thresholds;
+    thresholds.enable_logging = false;
+    SyntheticEngine engine(thresholds);
+    
+    const size_t count = 200000;
+    mt19937 gen(5);
+    uniform_int_distribution<size_t> pick(0, instrument_registry.size() - 1);
+    normal_distribution<double> walk(0.0, 0.5);
+    vector<double> mid(instrument_registry.size());
+    for (const auto& info : instrument_registry.all()) {
+        mid[info.id] = (info.asset == Asset::Bitcoin ? 67000.0 : 3500.0) * (info.market == MarketType::Futures ? 1.002 : 1.0);
+    }
+    vector<MarketEvent> events(count);
+    for (size_t n = 0; n < count; ++n) {
+        InstrumentId id = static_cast<InstrumentId>(pick(gen));
+        mid[id] += walk(gen);
+        events[n].type = MarketEventType::BboChange;
+        events[n].instrument = id;
+        events[n].bid = {Price::from_double(mid[id] - 0.05), Qty::from_double(1.0)};
+        events[n].ask = {Price::from_double(mid[id] + 0.05), Qty::from_double(1.0)};
+        events[n].sequence = static_cast<int64_t>(n);
+    }
+    
+    // The old loop, fed the same mids: every pair, its carry or funding
+    // factor recomputed each time from a string-keyed rate table.
+    mutex legacy_mutex;
+    mutex funding_mutex;
+    unordered_map<string, double> funding_rates;
+    unordered_map<SyntheticPairId, SyntheticPrice> legacy;
+    int64_t now_s = unix_seconds();
+    int64_t t0 = thread_cpu_ns();
+    for (const MarketEvent& event : events) {
+        engine.mids.apply(event);
+        engine.mids.clear_changed();
+        lock_guard<mutex> lock(legacy_mutex);
+        for (SyntheticPairId id = 0; id < engine.pairs.size(); ++id) {
+            const SyntheticPair& pair = engine.pairs[id];
+            double priced_mid = engine.mids.mid(pair.priced);
+            double reference_mid = engine.mids.mid(pair.reference);
+            if (priced_mid <= 0 || reference_mid <= 0) continue;
+            SyntheticPrice calc;
+            calc.exchange = exchange_name(pair.exchange);
+            calc.real_price = priced_mid;
+            if (pair.model == PricingModel::PerpetualFunding) {
+                double funding_rate = engine.config.default_funding_rate;
+                {
+                    lock_guard<mutex> funding_lock(funding_mutex);
+                    auto it = funding_rates.find(calc.exchange + "_" + instrument_registry.info(pair.reference).symbol);
+                    if (it != funding_rates.end()) funding_rate = it->second;
+                }
+                calc.synthetic_price = reference_mid - reference_mid * funding_rate;
+                calc.funding_rate = funding_rate;
+                calc.instrument_type = string(asset_name(pair.asset)) + " spot_vs_perpetual";
+            } else {
+                calc.synthetic_price = reference_mid * exp(engine.config.risk_free_rate *
+                                                           instrument_metadata.get(pair.priced).years_to_expiry(now_s));
+                calc.funding_rate = engine.config.risk_free_rate;
+                calc.instrument_type = string(asset_name(pair.asset)) + " futures_vs_spot";
+            }
+            calc.mispricing_percent = engine.calculate_mispricing_percent(calc.real_price, calc.synthetic_price);
+            calc.timestamp = chrono::steady_clock::now();
+            calc.is_valid = abs(calc.mispricing_percent) >= engine.config.min_mispricing_percent;
+            legacy[id] = calc;
+        }
+    }
+    int64_t t1 = thread_cpu_ns();
+    
+    size_t repriced = 0;
+    for (const MarketEvent& event : events) {
+        engine.mids.apply(event);
+        repriced += engine.reprice_changed();
+    }
+    int64_t t2 = thread_cpu_ns();
+    
+    // perp * (1 - f) and perp - perp * f may round apart in the last bit.
+    size_t mismatches = 0;
+    for (SyntheticPairId id = 0; id < engine.pairs.size(); ++id) {
+        SyntheticQuote quote = engine.quote(id);
+        const SyntheticPrice& old = legacy[id];
+        if (abs(quote.synthetic_price - old.synthetic_price) > 1e-9 * old.synthetic_price ||
+            abs(quote.mispricing_percent - old.mispricing_percent) > 1e-9) mismatches++;
+    }
+    
+    cout << count << " quote changes over " << engine.pairs.size() << " pairs" << endl;
+    cout << left << setw(24) << "Reprice every pair" << right << fixed << setprecision(1) << setw(8)
+         << (t1 - t0) / double(count) << " ns CPU per update, " << engine.pairs.size() << " pairs each" << endl;
+    cout << left << setw(24) << "Reprice changed pairs" << right << setw(8) << (t2 - t1) / double(count)
+         << " ns CPU per update, " << setprecision(2) << repriced / double(count) << " pairs each" << endl;
+    cout << "Final prices " << (mismatches == 0 ? "identical" : "DIFFER") << endl;
+    cout << string(60, '=') << endl;
+}